@@ -25,6 +25,9 @@
 #include "Host.h"
 #include "TAlias.h"
 
+#include <algorithm>
+#include <iterator>
+
 void AliasUnit::_uninstall(TAlias* pChild, const QString& packageName)
 {
     std::list<TAlias*>* childrenList = pChild->mpMyChildrenList;
@@ -90,6 +93,7 @@ void AliasUnit::addAliasRootNode(TAlias* pT, int parentPosition, int childPositi
     if (!moveAlias) {
         mAliasMap.insert(pT->getID(), pT);
     }
+    invalidateDispatchIndex();
 }
 
 void AliasUnit::reParentAlias(int childID, int oldParentID, int newParentID, int parentPosition, int childPosition)
@@ -114,6 +118,7 @@ void AliasUnit::reParentAlias(int childID, int oldParentID, int newParentID, int
         pChild->Tree<TAlias>::setParent(nullptr);
         addAliasRootNode(pChild, parentPosition, childPosition, true);
     }
+    invalidateDispatchIndex();
 }
 
 void AliasUnit::removeAliasRootNode(TAlias* pT)
@@ -128,6 +133,7 @@ void AliasUnit::removeAliasRootNode(TAlias* pT)
     }
     mAliasMap.remove(pT->getID());
     mAliasRootNodeList.remove(pT);
+    invalidateDispatchIndex();
 }
 
 void AliasUnit::removeAllTempAliases()
@@ -199,6 +205,8 @@ void AliasUnit::addAlias(TAlias* pT)
     }
 
     mAliasMap.insert(pT->getID(), pT);
+    // This alias may have turned a top level one into a folder:
+    invalidateDispatchIndex();
 }
 
 void AliasUnit::removeAlias(TAlias* pT)
@@ -213,6 +221,7 @@ void AliasUnit::removeAlias(TAlias* pT)
     }
 
     mAliasMap.remove(pT->getID());
+    invalidateDispatchIndex();
 }
 
 
@@ -221,16 +230,123 @@ int AliasUnit::getNewID()
     return ++mMaxID;
 }
 
+// Returns the literal text that any subject matching the given pattern must
+// start with, or an empty string if that cannot be determined cheaply. This
+// is deliberately conservative - anything it does not understand ends the
+// prefix - because a wrong answer would stop an alias from firing:
+/* static */ QString AliasUnit::literalPrefixOf(const QString& pattern)
+{
+    // Top-level alternation would mean the anchor only applies to the first
+    // alternative:
+    if (!pattern.startsWith(QLatin1Char('^')) || pattern.contains(QLatin1Char('|'))) {
+        return QString();
+    }
+
+    static const QString metaCharacters{qsl("^$.[]()?*+{}")};
+    static const QString optionalQuantifiers{qsl("?*{")};
+    QString prefix;
+    for (int i = 1, total = pattern.size(); i < total; ++i) {
+        QChar character = pattern.at(i);
+        if (character == QLatin1Char('\\')) {
+            // Only an escaped ASCII punctuation character or space is a plain
+            // literal, escaped letters and digits are classes, assertions,
+            // back-references or quoting:
+            if (i + 1 >= total || pattern.at(i + 1).unicode() > 0x7F || pattern.at(i + 1).isLetterOrNumber()) {
+                break;
+            }
+            character = pattern.at(++i);
+        } else if (metaCharacters.contains(character)) {
+            break;
+        }
+
+        if (i + 1 < total) {
+            const QChar next = pattern.at(i + 1);
+            if (optionalQuantifiers.contains(next)) {
+                // This character might not be present at all - and if it is
+                // the second half of a surrogate pair neither is the first:
+                if (character.isLowSurrogate() && !prefix.isEmpty() && prefix.back().isHighSurrogate()) {
+                    prefix.chop(1);
+                }
+                break;
+            }
+            if (next == QLatin1Char('+')) {
+                // This character is required but may be repeated:
+                prefix.append(character);
+                break;
+            }
+        }
+        prefix.append(character);
+    }
+    return prefix;
+}
+
+void AliasUnit::rebuildDispatchIndex()
+{
+    mDispatchEntries.clear();
+    mDispatchBuckets.clear();
+    mDispatchResidual.clear();
+    mDispatchEntries.reserve(mAliasRootNodeList.size());
+    for (auto alias : mAliasRootNodeList) {
+        DispatchEntry entry;
+        entry.mpAlias = alias;
+        // A folder's children are tried whether or not the folder's own
+        // pattern matches, so only childless aliases can be filtered:
+        if (!alias->hasChildren()) {
+            entry.mLiteralPrefix = literalPrefixOf(alias->getRegexCode());
+        }
+        const int index = static_cast<int>(mDispatchEntries.size());
+        if (entry.mLiteralPrefix.isEmpty()) {
+            mDispatchResidual.push_back(index);
+        } else {
+            mDispatchBuckets[entry.mLiteralPrefix.at(0)].push_back(index);
+        }
+        mDispatchEntries.push_back(entry);
+    }
+    mDispatchIndexIsDirty = false;
+}
+
+// Returns, in their original order, the top level aliases that need to be
+// tried against the given command:
+std::vector<TAlias*> AliasUnit::getDispatchCandidates(const QString& data)
+{
+    if (mDispatchIndexIsDirty) {
+        rebuildDispatchIndex();
+    }
+
+    std::vector<int> indexes;
+    if (!data.isEmpty()) {
+        const auto itBucket = mDispatchBuckets.constFind(data.at(0));
+        if (itBucket != mDispatchBuckets.cend()) {
+            const std::vector<int>& bucket = itBucket.value();
+            indexes.reserve(bucket.size() + mDispatchResidual.size());
+            std::copy_if(bucket.cbegin(), bucket.cend(), std::back_inserter(indexes), [&](const int index) {
+                return data.startsWith(mDispatchEntries.at(index).mLiteralPrefix);
+            });
+        }
+    }
+    const auto bucketEnd = static_cast<std::vector<int>::difference_type>(indexes.size());
+    indexes.insert(indexes.end(), mDispatchResidual.cbegin(), mDispatchResidual.cend());
+    std::inplace_merge(indexes.begin(), indexes.begin() + bucketEnd, indexes.end());
+
+    std::vector<TAlias*> candidates;
+    candidates.reserve(indexes.size());
+    for (const int index : indexes) {
+        candidates.push_back(mDispatchEntries.at(index).mpAlias);
+    }
+    return candidates;
+}
+
 bool AliasUnit::processDataStream(const QString& data)
 {
     TLuaInterpreter* Lua = mpHost->getLuaInterpreter();
     Lua->set_lua_string(qsl("command"), data);
     bool state = false;
+    // Encode the command once rather than once per alias:
+    const QByteArray dataUtf8 = data.toUtf8();
     //Using copy fixes https://github.com/Mudlet/Mudlet/issues/4297
-    auto copyOfNodeList = mAliasRootNodeList;
-    for (auto alias : copyOfNodeList) {
-        // = data.replace( "\n", "" );
-        if (alias->match(data)) {
+    const auto candidates = getDispatchCandidates(data);
+    for (auto alias : candidates) {
+        if (alias->match(data, dataUtf8)) {
             state = true;
         }
     }
@@ -24,12 +24,14 @@
 
 
 #include "pre_guard.h"
+#include <QHash>
 #include <QMultiMap>
 #include <QPointer>
 #include <QString>
 #include "post_guard.h"
 
 #include <list>
+#include <vector>
 
 class Host;
 class TAlias;
@@ -66,6 +68,7 @@ public:
     int getNewID();
     void markCleanup(TAlias* pT);
     void doCleanup();
+    void invalidateDispatchIndex() { mDispatchIndexIsDirty = true; }
 
     QMultiMap<QString, TAlias*> mLookupTable;
     std::list<TAlias*> mCleanupList;
@@ -82,6 +85,9 @@ private:
     void addAlias(TAlias* pT);
     void removeAliasRootNode(TAlias* pT);
     void removeAlias(TAlias*);
+    static QString literalPrefixOf(const QString&);
+    void rebuildDispatchIndex();
+    std::vector<TAlias*> getDispatchCandidates(const QString&);
 
     QPointer<Host> mpHost;
     QMap<int, TAlias*> mAliasMap;
@@ -91,6 +97,22 @@ private:
     int statsItemsTotal = 0;
     int statsTempItems = 0;
     int statsActiveItems = 0;
+
+    // Index of the top level aliases by the literal text that an anchored
+    // pattern (e.g. "^foo (.*)$") requires a command to start with, so that
+    // processDataStream(...) only tries the regexes of aliases that could
+    // possibly match. Folders and patterns without such a literal prefix go
+    // into the residual list and are always tried:
+    struct DispatchEntry
+    {
+        TAlias* mpAlias = nullptr;
+        QString mLiteralPrefix;
+    };
+    std::vector<DispatchEntry> mDispatchEntries;
+    // Both hold indexes into mDispatchEntries in ascending (root list) order:
+    QHash<QChar, std::vector<int>> mDispatchBuckets;
+    std::vector<int> mDispatchResidual;
+    bool mDispatchIndexIsDirty = true;
 };
 
 #endif // MUDLET_ALIASUNIT_H
@@ -54,6 +54,7 @@
 
 #include "pre_guard.h"
 #include <chrono>
+#include <cmath>
 #include <QtConcurrent>
 #include <QDialog>
 #include <QtUiTools>
@@ -651,7 +652,9 @@ void Host::createModuleBackup(const QString &filename, const QString &saveName)
     QFile::copy(filename, saveName + time);
 }
 
-void Host::writeModule(const QString &moduleName, const QString &filename)
+// Returns false if the module had not changed since it was last written so
+// the file (and any zip it is in) was left as it was:
+bool Host::writeModule(const QString &moduleName, const QString &filename)
 {
     QString xml_filename = filename;
     if (filename.endsWith(qsl("mpackage"), Qt::CaseInsensitive) || filename.endsWith(qsl("zip"), Qt::CaseInsensitive)) {
@@ -659,8 +662,11 @@ void Host::writeModule(const QString &moduleName, const QString &filename)
     }
     auto writer = new XMLexport(this);
     writers.insert(xml_filename, writer);
-    writer->writeModuleXML(moduleName, xml_filename);
+    if (!writer->writeModuleXML(moduleName, xml_filename)) {
+        return false;
+    }
     updateModuleZips(filename, moduleName);
+    return true;
 }
 
 void Host::waitForAsyncXmlSave()
@@ -693,8 +699,8 @@ void Host::saveModules(bool backup)
         if (backup) {
             createModuleBackup(filename, savePath + moduleName);
         }
-        writeModule(moduleName, filename);
-        if (entry[1].toInt()) {
+        // Other profiles only need to reload it if it was actually rewritten:
+        if (writeModule(moduleName, filename) && entry[1].toInt()) {
             mModulesToSync << moduleName;
         }
     }
@@ -874,6 +880,9 @@ void Host::resetProfile_phase2()
     mpConsole->resetMainConsole();
     mEventHandlerMap.clear();
     mEventMap.clear();
+    // Not mNextHighlighterId, so an id kept from before cannot come to refer
+    // to a highlighter created after the reset:
+    mHighlighterMap.clear();
     mLuaInterpreter.initLuaGlobals();
     mLuaInterpreter.loadGlobal();
     mBlockScriptCompile = false;
@@ -917,8 +926,15 @@ std::tuple<bool, QString, QString> Host::saveProfile(const QString& saveFolder,
     }
 
     QString filename_xml;
+    // The save that would be loaded now, which an unchanged profile can reuse
+    // rather than piling up identical time-stamped copies:
+    QString previous_filename_xml;
     if (saveName.isEmpty()) {
         filename_xml = qsl("%1/%2.xml").arg(directory_xml, QDateTime::currentDateTime().toString(qsl("yyyy-MM-dd#HH-mm-ss")));
+        const QStringList entries = QDir(directory_xml).entryList(QDir::Files, QDir::Time);
+        if (!entries.isEmpty()) {
+            previous_filename_xml = qsl("%1/%2").arg(directory_xml, entries.first());
+        }
     } else {
         filename_xml = qsl("%1/%2.xml").arg(directory_xml, saveName);
     }
@@ -954,7 +970,7 @@ std::tuple<bool, QString, QString> Host::saveProfile(const QString& saveFolder,
 
     auto writer = new XMLexport(this);
     writers.insert(qsl("profile"), writer);
-    writer->exportHost(filename_xml);
+    writer->exportHost(filename_xml, previous_filename_xml);
     mWritingHostAndModules = true;
     auto watcher = new QFutureWatcher<void>;
     mModuleFuture = QtConcurrent::run([=]() {
@@ -1530,6 +1546,14 @@ QPair<bool, QString> Host::resetAndRestartStopWatch(const int id)
     return qMakePair(false, qsl("stopwatch with id %1 not found").arg(id));
 }
 
+int Host::addHighlighter(QSharedPointer<THighlighter> pHighlighter)
+{
+    // Ids are never reused so a stale one held by a script cannot pick up a
+    // different highlighter:
+    mHighlighterMap.insert(++mNextHighlighterId, pHighlighter);
+    return mNextHighlighterId;
+}
+
 bool Host::makeStopWatchPersistent(const int id, const bool state)
 {
     auto pStopWatch = mStopWatchMap.value(id);
@@ -1708,15 +1732,18 @@ void Host::raiseEvent(const TEvent& pE)
         }
     }
 
+    const TProfiler::ItemType handlerType = pE.mArgumentList.at(0).startsWith(QLatin1String("gmcp.")) ? TProfiler::GmcpHandler : TProfiler::EventHandler;
     if (mAnonymousEventHandlerFunctions.contains(pE.mArgumentList.at(0))) {
         const QStringList functionsList = mAnonymousEventHandlerFunctions.value(pE.mArgumentList.at(0));
         for (int i = 0, total = functionsList.size(); i < total; ++i) {
+            const TProfilerSample profilerSample(mProfiler, handlerType, -1, functionsList.at(i), TProfilerSample::Run);
             mLuaInterpreter.callEventHandler(functionsList.at(i), pE);
         }
     }
     if (mAnonymousEventHandlerFunctions.contains(star)) {
         const QStringList functionsList = mAnonymousEventHandlerFunctions.value(star);
         for (int i = 0, total = functionsList.size(); i < total; ++i) {
+            const TProfilerSample profilerSample(mProfiler, handlerType, -1, functionsList.at(i), TProfilerSample::Run);
             mLuaInterpreter.callEventHandler(functionsList.at(i), pE);
         }
     }
@@ -3502,6 +3529,53 @@ bool Host::moveWindow(const QString& name, int x1, int y1)
     return false;
 }
 
+// Does a moveWindow(...) and a resizeWindow(...) with a single look-up and,
+// for the embedded widgets, a single geometry change:
+bool Host::setWindowGeometry(const QString& name, int x, int y, int width, int height)
+{
+    if (!mpConsole) {
+        return false;
+    }
+
+    if (auto pL = mpConsole->mLabelMap.value(name)) {
+        pL->setGeometry(x, y, width, height);
+        return true;
+    }
+
+    if (auto pC = mpConsole->mSubConsoleMap.value(name)) {
+        if (auto pD = mpConsole->mDockWidgetMap.value(name)) {
+            if (!pD->isFloating()) {
+                // Undock a docked window
+                pD->setFloating(true);
+            }
+
+            // A floating dock widget is moved by its frame but sized by its
+            // contents so this cannot be a setGeometry(...):
+            pD->move(x, y);
+            pD->resize(width, height);
+            return true;
+        }
+
+        // NOT a floatable/dockable "user window"
+        pC->setGeometry(x, y, width, height);
+        pC->mOldX = x;
+        pC->mOldY = y;
+        return true;
+    }
+
+    if (auto pS = mpConsole->mScrollBoxMap.value(name)) {
+        pS->setGeometry(x, y, width, height);
+        return true;
+    }
+
+    if (auto pN = mpConsole->mSubCommandLineMap.value(name)) {
+        pN->setGeometry(x, y, width, height);
+        return true;
+    }
+
+    return false;
+}
+
 std::pair<bool, QString> Host::setWindow(const QString& windowname, const QString& name, int x1, int y1, bool show)
 {
     if (!mpConsole) {
@@ -3739,6 +3813,56 @@ bool Host::resetCmdLineAction(const QString& name)
     return false;
 }
 
+// Sizes the "<gaugeName>_front" label of a gauge to show percent of the
+// "<gaugeName>_back" one, which always covers the whole gauge, so a gauge
+// update is a single geometry change rather than a round trip through the
+// Geyser constraint code. It is still a geometry change: painting the fill
+// onto one label instead would crop, rather than scale, any border or
+// gradient in the front label's style sheet, so that has not been done:
+std::pair<bool, QString> Host::setGaugeValue(const QString& gaugeName, const double percent, const QString& orientation)
+{
+    if (!mpConsole) {
+        return {false, qsl("no main console")};
+    }
+
+    auto pBack = mpConsole->mLabelMap.value(qsl("%1_back").arg(gaugeName));
+    auto pFront = mpConsole->mLabelMap.value(qsl("%1_front").arg(gaugeName));
+    if (!pBack || !pFront) {
+        return {false, qsl("gauge \"%1\" not found").arg(gaugeName)};
+    }
+    if (pBack->parentWidget() != pFront->parentWidget()) {
+        return {false, qsl("the front and back labels of gauge \"%1\" are not in the same window").arg(gaugeName)};
+    }
+
+    if (!std::isfinite(percent)) {
+        return {false, qsl("percentage must be a finite number")};
+    }
+
+    // Rounding anything outside the range of an int is undefined, hence the
+    // clamping; overflowing the gauge is left to the Lua code:
+    const QRect whole = pBack->geometry();
+    const double ratio = qBound(0.0, percent / 100.0, 1.0);
+    const int fillWidth = qRound(whole.width() * ratio);
+    const int fillHeight = qRound(whole.height() * ratio);
+    QRect fill;
+    if (orientation == QLatin1String("horizontal")) {
+        fill = QRect(whole.left(), whole.top(), fillWidth, whole.height());
+    } else if (orientation == QLatin1String("vertical")) {
+        fill = QRect(whole.left(), whole.top() + whole.height() - fillHeight, whole.width(), fillHeight);
+    } else if (orientation == QLatin1String("goofy")) {
+        fill = QRect(whole.left() + whole.width() - fillWidth, whole.top(), fillWidth, whole.height());
+    } else if (orientation == QLatin1String("batty")) {
+        fill = QRect(whole.left(), whole.top(), whole.width(), fillHeight);
+    } else {
+        return {false, qsl("\"%1\" is not a valid orientation, it should be \"horizontal\", \"vertical\", \"goofy\" or \"batty\"").arg(orientation)};
+    }
+
+    if (pFront->geometry() != fill) {
+        pFront->setGeometry(fill);
+    }
+    return {true, QString()};
+}
+
 bool Host::setLabelClickCallback(const QString& name, const int func)
 {
     if (!mpConsole) {
@@ -47,12 +47,14 @@
 #include <QList>
 #include <QMargins>
 #include <QPointer>
+#include <QSharedPointer>
 #include <QStack>
 #include <QTextStream>
 #include "post_guard.h"
 
 #include "TMxpMudlet.h"
 #include "TMxpProcessor.h"
+#include "TProfiler.h"
 
 class QDialog;
 class QDockWidget;
@@ -69,6 +71,7 @@ class TConsole;
 class TMainConsole;
 class dlgNotepad;
 class TMap;
+class THighlighter;
 class dlgIRC;
 class dlgPackageManager;
 class dlgModuleManager;
@@ -274,6 +277,11 @@ public:
     QPair<bool, QString> setStopWatchName(const QString&, const QString&);
     QPair<bool, QString> resetAndRestartStopWatch(const int);
 
+    // Highlighters prepared by createHighlighter() for applyHighlighter():
+    int addHighlighter(QSharedPointer<THighlighter>);
+    bool removeHighlighter(const int id) { return mHighlighterMap.remove(id); }
+    QSharedPointer<THighlighter> getHighlighter(const int id) const { return mHighlighterMap.value(id); }
+
     void startSpeedWalk();
     void startSpeedWalk(int sourceRoom, int targetRoom);
     void reloadModule(const QString& reloadModuleName, const QString& syncingFromHost = QString());
@@ -373,6 +381,8 @@ public:
     bool hideWindow(const QString&);
     bool resizeWindow(const QString&, int, int);
     bool moveWindow(const QString& name, int, int);
+    bool setWindowGeometry(const QString& name, int x, int y, int width, int height);
+    std::pair<bool, QString> setGaugeValue(const QString& gaugeName, double percent, const QString& orientation);
     std::pair<bool, QString> setWindow(const QString& windowname, const QString& name, int x1, int y1, bool show);
     std::pair<bool, QString> openMapWidget(const QString& area, int x, int y, int width, int height);
     std::pair<bool, QString> closeMapWidget();
@@ -457,6 +467,8 @@ public:
 
     TMxpMudlet mMxpClient;
     TMxpProcessor mMxpProcessor;
+    // Per item timing statistics, only gathered when it is enabled:
+    TProfiler mProfiler;
     QString mMediaLocationGMCP;
     QString mMediaLocationMSP;
     QTextStream mErrorLogStream;
@@ -748,11 +760,14 @@ private:
     void createMapper(const bool);
     void removePackageInfo(const QString &packageName, const bool);
     static void createModuleBackup(const QString &filename, const QString& saveName);
-    void writeModule(const QString &moduleName, const QString &filename);
+    bool writeModule(const QString &moduleName, const QString &filename);
     void waitForAsyncXmlSave();
     void saveModules(bool backup = true);
     void updateModuleZips(const QString &zipName, const QString &moduleName);
     void reloadModules();
+
+    QMap<int, QSharedPointer<THighlighter>> mHighlighterMap;
+    int mNextHighlighterId = 0;
     void startMapAutosave(const int interval);
     void timerEvent(QTimerEvent *event) override;
     void autoSaveMap();
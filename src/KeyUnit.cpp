@@ -69,18 +69,7 @@ void KeyUnit::uninstall(const QString& packageName)
 
 bool KeyUnit::processDataStream(const Qt::Key key, const Qt::KeyboardModifiers modifiers)
 {
-    bool isMatchFound = false;
-    for (auto keyObject : mKeyRootNodeList) {
-        if (keyObject->match(key, modifiers, mRunAllKeyMatches)) {
-            if (!mRunAllKeyMatches) {
-                return true;
-            }
-
-            isMatchFound = true;
-        }
-    }
-
-    return isMatchFound;
+    return mDispatchIndex.dispatch(mKeyRootNodeList, key, modifiers, mRunAllKeyMatches, [](TKey* pKey) { pKey->execute(); });
 }
 
 void KeyUnit::compileAll()
@@ -222,6 +211,7 @@ void KeyUnit::addKeyRootNode(TKey* pT, int parentPosition, int childPosition, bo
     if (!moveKey) {
         mKeyMap.insert(pT->getID(), pT);
     }
+    invalidateDispatchIndex();
 }
 
 void KeyUnit::reParentKey(int childID, int oldParentID, int newParentID, int parentPosition, int childPosition)
@@ -244,6 +234,7 @@ void KeyUnit::reParentKey(int childID, int oldParentID, int newParentID, int par
         pChild->Tree<TKey>::setParent(nullptr);
         addKeyRootNode(pChild, parentPosition, childPosition, true);
     }
+    invalidateDispatchIndex();
 }
 
 void KeyUnit::removeKeyRootNode(TKey* pT)
@@ -258,6 +249,7 @@ void KeyUnit::removeKeyRootNode(TKey* pT)
     }
     mKeyMap.remove(pT->getID());
     mKeyRootNodeList.remove(pT);
+    invalidateDispatchIndex();
 }
 
 TKey* KeyUnit::getKey(int id)
@@ -313,6 +305,7 @@ void KeyUnit::addKey(TKey* pT)
     }
 
     mKeyMap.insert(pT->getID(), pT);
+    invalidateDispatchIndex();
 }
 
 void KeyUnit::removeKey(TKey* pT)
@@ -326,6 +319,7 @@ void KeyUnit::removeKey(TKey* pT)
         mLookupTable.remove(pT->getName());
     }
     mKeyMap.remove(pT->getID());
+    invalidateDispatchIndex();
 }
 
 
@@ -24,6 +24,8 @@
  ***************************************************************************/
 
 
+#include "TKeyDispatchIndex.h"
+
 #include "pre_guard.h"
 #include <QMap>
 #include <QObject>
@@ -74,6 +76,9 @@ public:
     void doCleanup();
     void stopAllTriggers();
     void reenableAllTriggers();
+    // Call when a key binding is added, removed, moved or has its key or
+    // modifiers changed:
+    void invalidateDispatchIndex() { mDispatchIndex.invalidate(); }
 
 
     QMultiMap<QString, TKey*> mLookupTable;
@@ -106,6 +111,8 @@ private:
     int statsItemsTotal = 0;
     int statsTempItems = 0;
     int statsActiveItems = 0;
+    // Every key binding, grouped by its key and modifiers:
+    TKeyDispatchIndex<TKey> mDispatchIndex;
 };
 
 #endif // MUDLET_KEYUNIT_H
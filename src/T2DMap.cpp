@@ -913,14 +913,14 @@ inline void T2DMap::drawRoom(QPainter& painter,
 
     QBrush innerBrush = painter.brush();
     innerBrush.setStyle(Qt::NoBrush);
-    if (pRoom->getUp() > 0 || pRoom->exitStubs.contains(DIR_UP)) {
+    if (pRoom->getUp() > 0 || pRoom->hasExitStub(DIR_UP)) {
         QPolygonF poly_up;
         poly_up.append(QPointF(rx, ry + (mRoomHeight * rSize * allInsideTipOffsetFactor)));
         poly_up.append(QPointF(rx - (mRoomWidth * rSize * upDownXOrYFactor), ry + (mRoomHeight * rSize * upDownXOrYFactor)));
         poly_up.append(QPointF(rx + (mRoomWidth * rSize * upDownXOrYFactor), ry + (mRoomHeight * rSize * upDownXOrYFactor)));
         bool isDoor = true;
         QBrush brush = painter.brush();
-        switch (pRoom->doors.value(key_up)) {
+        switch (pRoom->getDoor(DIR_UP)) {
         case 1:
             brush.setColor(mOpenDoorColor);
             innerPen.setColor(mOpenDoorColor);
@@ -959,14 +959,14 @@ inline void T2DMap::drawRoom(QPainter& painter,
         }
     }
 
-    if (pRoom->getDown() > 0 || pRoom->exitStubs.contains(DIR_DOWN)) {
+    if (pRoom->getDown() > 0 || pRoom->hasExitStub(DIR_DOWN)) {
         QPolygonF poly_down;
         poly_down.append(QPointF(rx, ry - (mRoomHeight * rSize * allInsideTipOffsetFactor)));
         poly_down.append(QPointF(rx - (mRoomWidth * rSize * upDownXOrYFactor), ry - (mRoomHeight * rSize * upDownXOrYFactor)));
         poly_down.append(QPointF(rx + (mRoomWidth * rSize * upDownXOrYFactor), ry - (mRoomHeight * rSize * upDownXOrYFactor)));
         bool isDoor = true;
         QBrush brush = painter.brush();
-        switch (pRoom->doors.value(key_down)) {
+        switch (pRoom->getDoor(DIR_DOWN)) {
         case 1:
             brush.setColor(mOpenDoorColor);
             innerPen.setColor(mOpenDoorColor);
@@ -1002,7 +1002,7 @@ inline void T2DMap::drawRoom(QPainter& painter,
         }
     }
 
-    if (pRoom->getIn() > 0 || pRoom->exitStubs.contains(DIR_IN)) {
+    if (pRoom->getIn() > 0 || pRoom->hasExitStub(DIR_IN)) {
         QPolygonF poly_in_left;
         QPolygonF poly_in_right;
         poly_in_left.append(QPointF(rx - (mRoomWidth * rSize * allInsideTipOffsetFactor), ry));
@@ -1013,7 +1013,7 @@ inline void T2DMap::drawRoom(QPainter& painter,
         poly_in_right.append(QPointF(rx + (mRoomWidth * rSize * inOuterXFactor), ry - (mRoomHeight * rSize * inUpDownYFactor)));
         bool isDoor = true;
         QBrush brush = painter.brush();
-        switch (pRoom->doors.value(key_in)) {
+        switch (pRoom->getDoor(DIR_IN)) {
         case 1:
             brush.setColor(mOpenDoorColor);
             innerPen.setColor(mOpenDoorColor);
@@ -1051,7 +1051,7 @@ inline void T2DMap::drawRoom(QPainter& painter,
         }
     }
 
-    if (pRoom->getOut() > 0 || pRoom->exitStubs.contains(DIR_OUT)) {
+    if (pRoom->getOut() > 0 || pRoom->hasExitStub(DIR_OUT)) {
         QPolygonF poly_out_left;
         QPolygonF poly_out_right;
         poly_out_left.append(QPointF(rx - (mRoomWidth * rSize * outOuterXFactor), ry));
@@ -1062,7 +1062,7 @@ inline void T2DMap::drawRoom(QPainter& painter,
         poly_out_right.append(QPointF(rx + (mRoomWidth * rSize * outInterXFactor), ry - (mRoomHeight * rSize * outUpDownYFactor)));
         bool isDoor = true;
         QBrush brush = painter.brush();
-        switch (pRoom->doors.value(key_out)) {
+        switch (pRoom->getDoor(DIR_OUT)) {
         case 1:
             brush.setColor(mOpenDoorColor);
             innerPen.setColor(mOpenDoorColor);
@@ -2064,8 +2064,8 @@ void T2DMap::paintRoomExits(QPainter& painter, QPen& pen, QList<int>& exitList,
         }
 
         // draw exit stubs
-        for (const int direction : qAsConst(room->exitStubs)) {
-            if (direction >= DIR_NORTH && direction <= DIR_SOUTHWEST) {
+        for (int direction = DIR_NORTH; direction <= DIR_SOUTHWEST; ++direction) {
+            if (room->hasExitStub(direction)) {
                 // Stubs on non-XY plane exits are handled differently and we
                 // do not support special exit stubs (yet?)
                 const QVector3D uDirection = mpMap->scmUnitVectors.value(direction);
@@ -2074,7 +2074,7 @@ void T2DMap::paintRoomExits(QPainter& painter, QPen& pen, QList<int>& exitList,
                 // Draw the door lines before we draw the stub or the filled
                 // circle on the end - so that the latter overlays the doors
                 // if they get a bit large (at low exit size numbers)
-                if (room->doors.value(doorKey)) {
+                if (room->getDoor(direction)) {
                     drawDoor(painter, *room, doorKey, stubLine);
                 }
                 painter.save();
@@ -2262,30 +2262,22 @@ void T2DMap::paintRoomExits(QPainter& painter, QPen& pen, QList<int>& exitList,
             if (!room->doors.empty()) {
                 QString doorKey;
                 int doorStatus = 0;
-                if (room->getSouth() == rID && room->doors.contains(key_s)) {
+                if (room->getSouth() == rID && (doorStatus = room->getDoor(DIR_SOUTH))) {
                     doorKey = key_s;
-                    doorStatus = room->doors.value(doorKey);
-                } else if (room->getNorth() == rID && room->doors.contains(key_n)) {
+                } else if (room->getNorth() == rID && (doorStatus = room->getDoor(DIR_NORTH))) {
                     doorKey = key_n;
-                    doorStatus = room->doors.value(doorKey);
-                } else if (room->getSouthwest() == rID && room->doors.contains(key_sw)) {
+                } else if (room->getSouthwest() == rID && (doorStatus = room->getDoor(DIR_SOUTHWEST))) {
                     doorKey = key_sw;
-                    doorStatus = room->doors.value(doorKey);
-                } else if (room->getSoutheast() == rID && room->doors.contains(key_se)) {
+                } else if (room->getSoutheast() == rID && (doorStatus = room->getDoor(DIR_SOUTHEAST))) {
                     doorKey = key_se;
-                    doorStatus = room->doors.value(doorKey);
-                } else if (room->getNortheast() == rID && room->doors.contains(key_ne)) {
+                } else if (room->getNortheast() == rID && (doorStatus = room->getDoor(DIR_NORTHEAST))) {
                     doorKey = key_ne;
-                    doorStatus = room->doors.value(doorKey);
-                } else if (room->getNorthwest() == rID && room->doors.contains(key_nw)) {
+                } else if (room->getNorthwest() == rID && (doorStatus = room->getDoor(DIR_NORTHWEST))) {
                     doorKey = key_nw;
-                    doorStatus = room->doors.value(doorKey);
-                } else if (room->getWest() == rID && room->doors.contains(key_w)) {
+                } else if (room->getWest() == rID && (doorStatus = room->getDoor(DIR_WEST))) {
                     doorKey = key_w;
-                    doorStatus = room->doors.value(doorKey);
-                } else if (room->getEast() == rID && room->doors.contains(key_e)) {
+                } else if (room->getEast() == rID && (doorStatus = room->getDoor(DIR_EAST))) {
                     doorKey = key_e;
-                    doorStatus = room->doors.value(doorKey);
                 }
                 // Else not an XY-plane exit and doorStatus/doorKey will not be
                 // set to a usable value:
@@ -3875,7 +3867,7 @@ void T2DMap::slot_setRoomProperties(
             continue;
         }
         if (changeName) {
-            room->name = newName;
+            room->setName(newName);
         }
         if (changeRoomColor) {
             room->environment = newRoomColor;
@@ -27,6 +27,7 @@
 #include "Host.h"
 #include "TConsole.h"
 #include "TDebug.h"
+#include "TRegexCache.h"
 #include "mudlet.h"
 
 TAlias::TAlias(TAlias* parent, Host* pHost)
@@ -68,13 +69,20 @@ void TAlias::setName(const QString& name)
 }
 
 bool TAlias::match(const QString& haystack)
+{
+    return match(haystack, haystack.toUtf8());
+}
+
+// The caller supplies the UTF-8 form of the haystack so that it only has to
+// be encoded once however many aliases (and their children) are tried:
+bool TAlias::match(const QString& haystack, const QByteArray& haystackUtf8)
 {
     bool matchCondition = false;
     if (!isActive()) {
         if (isFolder()) {
             if (shouldBeActive()) {
                 for (auto alias : *mpMyChildrenList) {
-                    if (alias->match(haystack)) {
+                    if (alias->match(haystack, haystackUtf8)) {
                         matchCondition = true;
                     }
                 }
@@ -89,13 +97,10 @@ bool TAlias::match(const QString& haystack)
         return false; //regex compile error
     }
 
-#if defined(Q_OS_WIN32)
-    // strndup(3) - a safe strdup(3) does not seem to be available on mingw32 with GCC-4.9.2
-    char* haystackC = static_cast<char*>(malloc(strlen(haystack.toUtf8().constData()) + 1));
-    strcpy(haystackC, haystack.toUtf8().constData());
-#else
-    char* haystackC = strndup(haystack.toUtf8().constData(), strlen(haystack.toUtf8().constData()));
-#endif
+    const TProfilerSample profilerSample(mpHost->mProfiler, TProfiler::Alias, mID, mName, TProfilerSample::Match);
+
+    // pcre_exec(...) does not modify the subject so there is no need to copy it:
+    const char* haystackC = haystackUtf8.constData();
 
     // These must be initialised before any goto so the latter does not jump
     // over them:
@@ -138,7 +143,7 @@ bool TAlias::match(const QString& haystack)
     matchCondition = true; // alias has matched
 
     for (i = 0; i < rc; i++) {
-        char* substring_start = haystackC + ovector[2 * i];
+        const char* substring_start = haystackC + ovector[2 * i];
         int substring_length = ovector[2 * i + 1] - ovector[2 * i];
 
         std::string match;
@@ -205,7 +210,7 @@ bool TAlias::match(const QString& haystack)
         }
 
         for (i = 0; i < rc; i++) {
-            char* substring_start = haystackC + ovector[2 * i];
+            const char* substring_start = haystackC + ovector[2 * i];
             int substring_length = ovector[2 * i + 1] - ovector[2 * i];
             std::string match;
             if (substring_length < 1) {
@@ -234,34 +239,29 @@ END : {
 
 MUD_ERROR:
     for (auto childAlias : *mpMyChildrenList) {
-        if (childAlias->match(haystack)) {
+        if (childAlias->match(haystack, haystackUtf8)) {
             matchCondition = true;
         }
     }
 
-    free(haystackC);
     return matchCondition;
 }
 
-static void pcre_deleter(pcre* pointer)
-{
-    pcre_free(pointer);
-}
-
 void TAlias::setRegexCode(const QString& code)
 {
     mRegexCode = code;
     compileRegex();
+    if (mpHost) {
+        // The pattern determines which commands this alias is tried against:
+        mpHost->getAliasUnit()->invalidateDispatchIndex();
+    }
 }
 
 void TAlias::compileRegex()
 {
     const char* error;
-    int erroffset;
 
-    // PCRE_UTF8 needed to run compile in UTF-8 mode
-    // PCRE_UCP needed for \d, \w etc. to use Unicode properties:
-    QSharedPointer<pcre> re(pcre_compile(mRegexCode.toUtf8().constData(), PCRE_UTF8 | PCRE_UCP, &error, &erroffset, nullptr), pcre_deleter);
+    QSharedPointer<pcre> re = TRegexCache::compile(mRegexCode.toUtf8(), &error);
 
     if (re == nullptr) {
         mOK_init = false;
@@ -344,6 +344,7 @@ bool TAlias::compileScript()
 
 void TAlias::execute()
 {
+    const TProfilerSample profilerSample(mpHost->mProfiler, TProfiler::Alias, mID, mName, TProfilerSample::Run);
     if (!mCommand.isEmpty()) {
         mpHost->send(mCommand);
     }
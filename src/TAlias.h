@@ -65,6 +65,7 @@ public:
     QString getCommand() const { return mCommand; }
 
     bool match(const QString& toMatch);
+    bool match(const QString& toMatch, const QByteArray& toMatchUtf8);
     bool registerAlias();
 
     TAlias() = default;
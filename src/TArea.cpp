@@ -157,6 +157,11 @@ void TArea::determineAreaExitsOfRoom(int id)
         return;
     }
 
+    if (mpMap && mpMap->isInBatchUpdate()) {
+        mpMap->deferAreaExitsOfRoomRecalculation(id);
+        return;
+    }
+
     TRoom* pR = mpRoomDB->getRoom(id);
     if (!pR) {
         return;
@@ -241,6 +246,11 @@ void TArea::determineAreaExitsOfRoom(int id)
 
 void TArea::determineAreaExits()
 {
+    if (mpMap && mpMap->isInBatchUpdate()) {
+        mpMap->deferAreaRecalculation(this);
+        return;
+    }
+
     mAreaExits.clear();
     QSetIterator<int> itRoom(rooms);
     while (itRoom.hasNext()) {
@@ -372,6 +382,13 @@ void TArea::addRoom(int id)
 
 void TArea::calcSpan()
 {
+    if (mpMap && mpMap->isInBatchUpdate()) {
+        // Done once for the whole batch when it ends:
+        mIsDirty = true;
+        mpMap->deferAreaRecalculation(this);
+        return;
+    }
+
     xminForZ.clear();
     yminForZ.clear();
     xmaxForZ.clear();
@@ -584,7 +601,11 @@ int TArea::createLabelId() const
     return labelId;
 }
 
-void TArea::writeJsonArea(QJsonArray& array) const
+// Returns the area as a stand-alone object so that the caller can turn it into
+// text (on another thread) without keeping every area of the map in memory at
+// once. If the export is cancelled part way through the result is incomplete
+// and the caller is expected to discard it:
+QJsonObject TArea::writeJsonArea() const
 {
     QJsonObject areaObj;
     const int id = mpRoomDB->getAreaID(const_cast<TArea*>(this));
@@ -616,7 +637,7 @@ void TArea::writeJsonArea(QJsonArray& array) const
             if (currentRoomCount % 10 == 0) {
                 if (mpMap->incrementJsonProgressDialog(true, true, 10)) {
                     // Cancel has been hit - so give up straight away:
-                    return;
+                    return areaObj;
                 }
             }
         }
@@ -632,8 +653,7 @@ void TArea::writeJsonArea(QJsonArray& array) const
     // quickly (from the rooms) even if it has a number of labels to do.
 
     writeJsonLabels(areaObj);
-    const QJsonValue areaValue{areaObj};
-    array.append(areaValue);
+    return areaObj;
 }
 
 std::pair<int, QString> TArea::readJsonArea(const QJsonArray& array, const int areaIndex)
@@ -644,9 +664,12 @@ std::pair<int, QString> TArea::readJsonArea(const QJsonArray& array, const int a
     gridMode = areaObj.value(QLatin1String("gridMode")).toBool();
     readJsonUserData(areaObj.value(QLatin1String("userData")).toObject());
     int roomCount = 0;
-    for (int roomIndex = 0, total = areaObj.value(QLatin1String("rooms")).toArray().count(); roomIndex < total; ++roomIndex) {
+    // Look the rooms up once rather than searching the area object again for
+    // every room:
+    const QJsonArray roomsArray{areaObj.value(QLatin1String("rooms")).toArray()};
+    for (int roomIndex = 0, total = roomsArray.count(); roomIndex < total; ++roomIndex) {
         TRoom* pR = new TRoom(mpRoomDB);
-        const int roomId = pR->readJsonRoom(areaObj.value(QLatin1String("rooms")).toArray(), roomIndex, id);
+        const int roomId = pR->readJsonRoom(roomsArray, roomIndex, id);
         rooms.insert(roomId);
         // This also sets the room id for the TRoom:
         mpRoomDB->addRoom(roomId, pR, true);
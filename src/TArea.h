@@ -62,7 +62,7 @@ public:
     QList<int> getRoomsByPosition(int x, int y, int z);
     QMap<int, QMap<int, QMultiMap<int, int>>> koordinatenSystem();
     int createLabelId() const;
-    void writeJsonArea(QJsonArray&) const;
+    QJsonObject writeJsonArea() const;
     std::pair<int, QString> readJsonArea(const QJsonArray&, const int);
     QList<int> getPermanentLabelIds() const;
     bool hasPermanentLabels() const;
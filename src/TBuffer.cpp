@@ -24,8 +24,10 @@
 #include "TBuffer.h"
 
 #include "mudlet.h"
+#include "TConsole.h"
 #include "TEvent.h"
 #include "TStringUtils.h"
+#include "TTextEdit.h"
 
 #include "pre_guard.h"
 #include <QTextBoundaryFinder>
@@ -33,6 +35,13 @@
 #include <QRegularExpression>
 #include "post_guard.h"
 
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MUDLET_HAS_SSE2_SCAN
+#endif
+
 // Define this to get qDebug() messages about the decoding of UTF-8 data when it
 // is not the single bytes of pure ASCII text:
 // #define DEBUG_UTF8_PROCESSING
@@ -55,13 +64,51 @@
 //#define DEBUG_MXP_PROCESSING
 
 
-TChar::TChar(const QColor& foreground, const QColor& background, const TChar::AttributeFlags flags, const int linkIndex)
-: mFgColor(foreground)
-, mBgColor(background)
-, mFlags(flags)
-, mLinkIndex(linkIndex)
+namespace {
+// Returns the number of bytes from the start of data that are printable ASCII
+// (Space to '~') - those are the only bytes which decode to the same single
+// QChar in EVERY encoding that we support and which cannot start or end any
+// out-of-band sequence (ESC, IAC-derived 0xFF prompt marker, CR/LF, etc.) so
+// a run of them can be appended to the current line in one go. When
+// isPendingEscape is true the '[' and ']' characters also end the run as they
+// would start a CSI/OSC sequence:
+size_t plainAsciiRunLength(const char* data, const size_t length, const bool isPendingEscape)
 {
+    size_t position = 0;
+#if defined(MUDLET_HAS_SSE2_SCAN)
+    // Treating the bytes as signed: anything above 0x7F is negative so the
+    // single "greater than 0x1F" test also rejects all non-ASCII bytes:
+    const __m128i lowerBound = _mm_set1_epi8(0x1F);
+    const __m128i upperBound = _mm_set1_epi8(0x7F);
+    while (position + 16 <= length) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+        const __m128i isPlain = _mm_and_si128(_mm_cmpgt_epi8(chunk, lowerBound), _mm_cmplt_epi8(chunk, upperBound));
+        if (_mm_movemask_epi8(isPlain) != 0xFFFF) {
+            // The end of the run is somewhere in this stride, the scalar loop
+            // below will find exactly where:
+            break;
+        }
+        position += 16;
+    }
+#endif
+    while (position < length) {
+        const auto byte = static_cast<quint8>(data[position]);
+        if (byte < 0x20 || byte > 0x7E) {
+            break;
+        }
+        ++position;
+    }
+
+    if (isPendingEscape) {
+        for (size_t i = 0; i < position; ++i) {
+            if (data[i] == '[' || data[i] == ']') {
+                return i;
+            }
+        }
+    }
+    return position;
 }
+} // namespace
 
 TChar::TChar(TConsole* pC)
 : mFgColor(pC ? pC->mFormatCurrent.foreground() : QColorConstants::White)
@@ -92,17 +139,6 @@ bool TChar::operator==(const TChar& other)
     return true;
 }
 
-// Copy constructor - because it is resetting the mIsSelected flag it is NOT a
-// default copy constructor:
-TChar::TChar(const TChar& copy)
-: mFgColor(copy.mFgColor)
-, mBgColor(copy.mBgColor)
-, mFlags(copy.mFlags)
-, mIsSelected(false)
-, mLinkIndex(copy.mLinkIndex)
-{
-}
-
 quint8 TChar::alternateFont() const
 {
     // As this is the most likely case check it first:
@@ -688,6 +724,21 @@ void TBuffer::translateToPlainText(std::string& incoming, const bool isFromServe
 
         // We are outside of a CSI or OSC sequence if we get to here:
 
+        // Fast path: most of the incoming data is runs of printable ASCII
+        // between the ANSI/out-of-band sequences and line endings, they all
+        // share the same formatting so append them as a block rather than
+        // going through the per-byte decoding below. MXP has to see every
+        // byte of the content though, so that has to take the slow path:
+        if (!(mpHost->mMxpProcessor.isEnabled() && mpHost->mServerMXPenabled)) {
+            const size_t runLength = plainAsciiRunLength(localBuffer.data() + localBufferPosition, localBufferLength - localBufferPosition, mGotESC);
+            if (runLength > 1) {
+                mMudLine.append(QLatin1String(localBuffer.data() + localBufferPosition, static_cast<int>(runLength)));
+                mMudBuffer.insert(mMudBuffer.end(), runLength, currentTextFormat());
+                localBufferPosition += runLength;
+                continue;
+            }
+        }
+
         if (mpHost->mMxpProcessor.isEnabled()) {
             if (mpHost->mServerMXPenabled) {
                 if (mpHost->mMxpProcessor.mode() != MXP_MODE_LOCKED) {
@@ -767,11 +818,11 @@ COMMIT_LINE:
                     lineBuffer << QString();
                 }
                 buffer.push_back(mMudBuffer);
-                timeBuffer << QTime::currentTime().toString(timeStampFormat);
+                timeBuffer.push_back(QDateTime::currentMSecsSinceEpoch());
                 if (ch == '\xff') {
-                    promptBuffer.append(true);
+                    promptBuffer.push_back(true);
                 } else {
-                    promptBuffer.append(false);
+                    promptBuffer.push_back(false);
                 }
             } else {
                 if (!mMudLine.isEmpty()) {
@@ -784,7 +835,7 @@ COMMIT_LINE:
                     lineBuffer.back().append(QString());
                 }
                 buffer.back() = mMudBuffer;
-                timeBuffer.back() = QTime::currentTime().toString(timeStampFormat);
+                timeBuffer.back() = QDateTime::currentMSecsSinceEpoch();
                 if (ch == '\xff') {
                     promptBuffer.back() = true;
                 } else {
@@ -805,9 +856,9 @@ COMMIT_LINE:
             std::deque<TChar> const newLine;
             buffer.push_back(newLine);
             lineBuffer.push_back(QString());
-            timeBuffer.push_back(QString());
-            promptBuffer << false;
-            if (static_cast<int>(buffer.size()) > mLinesLimit) {
+            timeBuffer.push_back(csmNoTimeStamp);
+            promptBuffer.push_back(false);
+            if (isOverLinesLimit()) {
                 // Whilst we also include a call to TConsole::handleLinesOverflowEvent(...)
                 // in all other methods where the following is used (because
                 // both need to monitor the number of lines of text in the
@@ -878,35 +929,7 @@ COMMIT_LINE:
             }
         }
 
-        const TChar::AttributeFlags attributeFlags =
-                ( ((mBold || mpHost->mMxpClient.bold()) ? TChar::Bold : TChar::None)
-                | (mFaint ? TChar::Faint : TChar::None)
-                | ((mItalics || mpHost->mMxpClient.italic()) ? TChar::Italic : TChar::None)
-                | (mOverline ? TChar::Overline : TChar::None)
-                | (mReverse ? TChar::Reverse : TChar::None)
-                | ((mStrikeOut || mpHost->mMxpClient.strikeOut()) ? TChar::StrikeOut : TChar::None)
-                | ((mUnderline || mpHost->mMxpClient.underline()) ? TChar::Underline : TChar::None)
-                | (mFastBlink ? TChar::FastBlink : (mBlink ? TChar::Blink :TChar::None))
-                | (TChar::alternateFontFlag(mAltFont))
-                | (mConcealed ? TChar::Concealed : TChar::None));
-
-        TChar c((mpHost && mpHost->mBoldIsBright && mMayShift8ColorSet && mBold) ? mForeGroundColorLight
-                                                                                     : mForeGroundColor,
-                mBackGroundColor,
-                attributeFlags);
-
-        if (mpHost->mMxpClient.isInLinkMode()) {
-            c.mLinkIndex = mLinkStore.getCurrentLinkID();
-            c.mFlags |= TChar::Underline;
-        }
-
-        if (mpHost->mMxpClient.hasFgColor()) {
-            c.mFgColor = mpHost->mMxpClient.getFgColor();
-        }
-
-        if (mpHost->mMxpClient.hasBgColor()) {
-            c.mBgColor = mpHost->mMxpClient.getBgColor();
-        }
+        const TChar c = currentTextFormat();
 
         if (isTwoTCharsNeeded) {
             // CHECK: Do we need to duplicate stuff for mMXP_LINK_MODE - yes I think we do:
@@ -920,6 +943,43 @@ COMMIT_LINE:
     }
 }
 
+// Produces the TChar that new text from the Game Server is to be given, based
+// upon the current ANSI SGR state and any MXP formatting in effect:
+TChar TBuffer::currentTextFormat() const
+{
+    const TChar::AttributeFlags attributeFlags =
+            ( ((mBold || mpHost->mMxpClient.bold()) ? TChar::Bold : TChar::None)
+            | (mFaint ? TChar::Faint : TChar::None)
+            | ((mItalics || mpHost->mMxpClient.italic()) ? TChar::Italic : TChar::None)
+            | (mOverline ? TChar::Overline : TChar::None)
+            | (mReverse ? TChar::Reverse : TChar::None)
+            | ((mStrikeOut || mpHost->mMxpClient.strikeOut()) ? TChar::StrikeOut : TChar::None)
+            | ((mUnderline || mpHost->mMxpClient.underline()) ? TChar::Underline : TChar::None)
+            | (mFastBlink ? TChar::FastBlink : (mBlink ? TChar::Blink :TChar::None))
+            | (TChar::alternateFontFlag(mAltFont))
+            | (mConcealed ? TChar::Concealed : TChar::None));
+
+    TChar c((mpHost && mpHost->mBoldIsBright && mMayShift8ColorSet && mBold) ? mForeGroundColorLight
+                                                                                 : mForeGroundColor,
+            mBackGroundColor,
+            attributeFlags);
+
+    if (mpHost->mMxpClient.isInLinkMode()) {
+        c.mLinkIndex = mLinkStore.getCurrentLinkID();
+        c.mFlags |= TChar::Underline;
+    }
+
+    if (mpHost->mMxpClient.hasFgColor()) {
+        c.mFgColor = mpHost->mMxpClient.getFgColor();
+    }
+
+    if (mpHost->mMxpClient.hasBgColor()) {
+        c.mBgColor = mpHost->mMxpClient.getBgColor();
+    }
+
+    return c;
+}
+
 void TBuffer::decodeSGR38(const QStringList& parameters, bool isColonSeparated)
 {
 #if defined(DEBUG_SGR_PROCESSING)
@@ -2100,7 +2160,7 @@ void TBuffer::append(const QString& text, int sub_start, int sub_end, TChar form
     // CHECK: What about other Unicode line breaks, e.g. soft-hyphen:
     const QString lineBreaks = qsl(",.- ");
 
-    if (static_cast<int>(buffer.size()) > mLinesLimit) {
+    if (isOverLinesLimit()) {
         shrinkBuffer();
     }
     int last = buffer.size() - 1;
@@ -2115,8 +2175,8 @@ void TBuffer::append(const QString& text, int sub_start, int sub_end, TChar form
         newLine.push_back(c);
         buffer.push_back(newLine);
         lineBuffer.push_back(QString());
-        timeBuffer << QTime::currentTime().toString(timeStampFormat);
-        promptBuffer << false;
+        timeBuffer.push_back(QDateTime::currentMSecsSinceEpoch());
+        promptBuffer.push_back(false);
         last = 0;
     }
     if (text.isEmpty()) {
@@ -2141,8 +2201,8 @@ void TBuffer::append(const QString& text, int sub_start, int sub_end, TChar form
             std::deque<TChar> const newLine;
             buffer.push_back(newLine);
             lineBuffer.push_back(QString());
-            timeBuffer << blankTimeStamp;
-            promptBuffer << false;
+            timeBuffer.push_back(csmBlankTimeStamp);
+            promptBuffer.push_back(false);
             firstChar = true;
             continue;
         }
@@ -2174,8 +2234,8 @@ void TBuffer::append(const QString& text, int sub_start, int sub_end, TChar form
                     } else {
                         lineBuffer.append(QString());
                     }
-                    timeBuffer << blankTimeStamp;
-                    promptBuffer << false;
+                    timeBuffer.push_back(csmBlankTimeStamp);
+                    promptBuffer.push_back(false);
                     log(size() - 2, size() - 2);
                     // Was absent causing loss of all but last line of wrapped
                     // long lines of user input and some other console displayed
@@ -2192,7 +2252,7 @@ void TBuffer::append(const QString& text, int sub_start, int sub_end, TChar form
                 linkID);
         buffer.back().push_back(c);
         if (firstChar) {
-            timeBuffer.back() = QTime::currentTime().toString(timeStampFormat);
+            timeBuffer.back() = QDateTime::currentMSecsSinceEpoch();
             firstChar = false;
         }
     }
@@ -2274,7 +2334,7 @@ void TBuffer::append(const QString& text, int sub_start, int sub_end, const QCol
     // CHECK: What about other Unicode line breaks, e.g. soft-hyphen:
     const QString lineBreaks = qsl(",.- ");
 
-    if (static_cast<int>(buffer.size()) > mLinesLimit) {
+    if (isOverLinesLimit()) {
         shrinkBuffer();
     }
     int last = buffer.size() - 1;
@@ -2284,8 +2344,8 @@ void TBuffer::append(const QString& text, int sub_start, int sub_end, const QCol
         newLine.push_back(c);
         buffer.push_back(newLine);
         lineBuffer.push_back(QString());
-        timeBuffer << QTime::currentTime().toString(timeStampFormat);
-        promptBuffer << false;
+        timeBuffer.push_back(QDateTime::currentMSecsSinceEpoch());
+        promptBuffer.push_back(false);
         last = 0;
     }
     if (text.isEmpty()) {
@@ -2307,8 +2367,8 @@ void TBuffer::append(const QString& text, int sub_start, int sub_end, const QCol
             std::deque<TChar> const newLine;
             buffer.push_back(newLine);
             lineBuffer.push_back(QString());
-            timeBuffer << blankTimeStamp;
-            promptBuffer << false;
+            timeBuffer.push_back(csmBlankTimeStamp);
+            promptBuffer.push_back(false);
             firstChar = true;
             continue;
         }
@@ -2341,8 +2401,8 @@ void TBuffer::append(const QString& text, int sub_start, int sub_end, const QCol
                     } else {
                         lineBuffer.append(QString());
                     }
-                    timeBuffer << blankTimeStamp;
-                    promptBuffer << false;
+                    timeBuffer.push_back(csmBlankTimeStamp);
+                    promptBuffer.push_back(false);
                     log(size() - 2, size() - 2);
                     // Was absent causing loss of all but last line of wrapped
                     // long lines of user input and some other console displayed
@@ -2355,7 +2415,7 @@ void TBuffer::append(const QString& text, int sub_start, int sub_end, const QCol
         const TChar c(fgColor, bgColor, (mEchoingText ? (TChar::Echo | flags) : flags), linkID);
         buffer.back().push_back(c);
         if (firstChar) {
-            timeBuffer.back() = QTime::currentTime().toString(timeStampFormat);
+            timeBuffer.back() = QDateTime::currentMSecsSinceEpoch();
             firstChar = false;
         }
     }
@@ -2373,7 +2433,7 @@ void TBuffer::appendLine(const QString& text, const int sub_start, const int sub
     if (sub_end < 0) {
         return;
     }
-    if (static_cast<int>(buffer.size()) > mLinesLimit) {
+    if (isOverLinesLimit()) {
         shrinkBuffer();
     }
     int lastLine = buffer.size() - 1;
@@ -2384,8 +2444,8 @@ void TBuffer::appendLine(const QString& text, const int sub_start, const int sub
         newLine.push_back(c);
         buffer.push_back(newLine);
         lineBuffer.push_back(QString());
-        timeBuffer << QTime::currentTime().toString(timeStampFormat);
-        promptBuffer << false;
+        timeBuffer.push_back(QDateTime::currentMSecsSinceEpoch());
+        promptBuffer.push_back(false);
         lastLine = 0;
     }
 
@@ -2408,7 +2468,7 @@ void TBuffer::appendLine(const QString& text, const int sub_start, const int sub
         const TChar c(fgColor, bgColor, (mEchoingText ? (TChar::Echo | flags) : flags), linkID);
         buffer.back().push_back(c);
         if (firstChar) {
-            timeBuffer.back() = QTime::currentTime().toString(timeStampFormat);
+            timeBuffer.back() = QDateTime::currentMSecsSinceEpoch();
             firstChar = false;
         }
     }
@@ -2604,7 +2664,7 @@ inline int TBuffer::wrap(int startLine)
     }
     std::queue<std::deque<TChar>> queue;
     QStringList tempList;
-    QStringList timeList;
+    QList<qint64> timeList;
     QList<bool> promptList;
     int lineCount = 0;
     const TChar pSpace(mpConsole);
@@ -2612,7 +2672,7 @@ inline int TBuffer::wrap(int startLine)
         const bool isPrompt = promptBuffer[i];
         std::deque<TChar> newLine;
         QString lineText = "";
-        const QString time = timeBuffer[i];
+        const qint64 time = timeBuffer[i];
         int indent = 0;
         if (static_cast<int>(buffer[i].size()) >= mWrapAt) {
             for (int i3 = 0; i3 < mWrapIndent; ++i3) {
@@ -2659,7 +2719,7 @@ inline int TBuffer::wrap(int startLine)
                 tempList.append(QString());
                 std::deque<TChar> const emptyLine;
                 queue.push(emptyLine);
-                timeList.append(QString());
+                timeList.append(csmNoTimeStamp);
                 promptList.append(false);
             } else {
                 queue.push(newLine);
@@ -2689,11 +2749,11 @@ inline int TBuffer::wrap(int startLine)
     for (int i = 0, total = tempList.size(); i < total; ++i) {
         if (tempList[i].size() < 1) {
             lineBuffer.append(QString());
-            timeBuffer.append(QString());
+            timeBuffer.push_back(csmNoTimeStamp);
             promptBuffer.push_back(false);
         } else {
             lineBuffer.append(tempList[i]);
-            timeBuffer.append(timeList[i]);
+            timeBuffer.push_back(timeList[i]);
             promptBuffer.push_back(promptList[i]);
         }
     }
@@ -2737,7 +2797,7 @@ void TBuffer::log(int fromLine, int toLine)
             // This only handles a single line of logged text at a time:
             linesToLog << bufferToHtml(mpHost->mIsLoggingTimestamps, i);
         } else {
-            linesToLog << ((mpHost->mIsLoggingTimestamps && !timeBuffer.at(i).isEmpty()) ? timeBuffer.at(i).left(timeStampFormat.length()) : QString()) % lineBuffer.at(i) % QChar::LineFeed;
+            linesToLog << ((mpHost->mIsLoggingTimestamps && timeBuffer.at(i) != csmNoTimeStamp) ? timeStampAt(i) : QString()) % lineBuffer.at(i) % QChar::LineFeed;
         }
     }
 
@@ -2840,10 +2900,10 @@ int TBuffer::wrapLine(int startLine, int screenWidth, int indentSize, TChar& for
 
     buffer.erase(buffer.begin() + startLine);
     lineBuffer.removeAt(startLine);
-    const QString time = timeBuffer.at(startLine);
-    timeBuffer.removeAt(startLine);
+    const qint64 time = timeBuffer.at(startLine);
+    timeBuffer.erase(timeBuffer.begin() + startLine);
     const bool isPrompt = promptBuffer.at(startLine);
-    promptBuffer.removeAt(startLine);
+    promptBuffer.erase(promptBuffer.begin() + startLine);
 
     const int insertedLines = queue.size() - 1;
     int i = 0;
@@ -2855,8 +2915,8 @@ int TBuffer::wrapLine(int startLine, int screenWidth, int indentSize, TChar& for
 
     for (int i = 0, total = tempList.size(); i < total; ++i) {
         lineBuffer.insert(startLine + i, tempList[i]);
-        timeBuffer.insert(startLine + i, time);
-        promptBuffer.insert(startLine + i, isPrompt);
+        timeBuffer.insert(timeBuffer.begin() + startLine + i, time);
+        promptBuffer.insert(promptBuffer.begin() + startLine + i, isPrompt);
     }
     log(startLine, startLine + tempList.size() - 1);
     return insertedLines > 0 ? insertedLines : 0;
@@ -2991,7 +3051,7 @@ void TBuffer::clear()
     std::deque<TChar> const newLine;
     buffer.push_back(newLine);
     lineBuffer << QString();
-    timeBuffer << QString();
+    timeBuffer.push_back(csmNoTimeStamp);
     promptBuffer.push_back(false);
 }
 
@@ -3000,18 +3060,50 @@ bool TBuffer::deleteLine(int y)
     return deleteLines(y, y);
 }
 
+// Lines paged back in from the scrollback archive can take the buffer over
+// its limit; they are left alone whilst the upper pane is scrolled back as
+// trimming them then would archive the very lines being looked at, and the
+// view would jump:
+bool TBuffer::isOverLinesLimit() const
+{
+    if (static_cast<int>(buffer.size()) <= mLinesLimit) {
+        return false;
+    }
+
+    return !mpConsole || !mpConsole->mpScrollbackArchive || mpConsole->mUpperPane->mIsTailMode;
+}
+
+// Returns how many lines were dropped, for use once the upper pane is back at
+// the bottom so that lines restored from the scrollback archive do not have
+// to wait for the next incoming one to be trimmed off again:
+int TBuffer::trimToLinesLimit()
+{
+    const int oldSize = static_cast<int>(buffer.size());
+    if (isOverLinesLimit()) {
+        shrinkBuffer();
+    }
+    return oldSize - static_cast<int>(buffer.size());
+}
+
 void TBuffer::shrinkBuffer()
 {
-    for (int i = 0; i < mBatchDeleteSize; ++i) {
-        lineBuffer.pop_front();
-        promptBuffer.pop_front();
-        timeBuffer.pop_front();
-        buffer.pop_front();
-        mCursorY--;
+    // Drop the whole batch from the front of each column in one go rather
+    // than a line at a time - or everything over the limit if lines restored
+    // from the scrollback archive have taken it further over than that:
+    const int linesToDrop = std::min(std::max(mBatchDeleteSize, static_cast<int>(buffer.size()) - mLinesLimit), static_cast<int>(buffer.size()));
+    if (mpConsole && mpConsole->mpScrollbackArchive) {
+        for (int i = 0; i < linesToDrop; ++i) {
+            mpConsole->mpScrollbackArchive->append({std::move(buffer[i]), lineBuffer.at(i), timeBuffer[i], promptBuffer[i]});
+        }
     }
+    buffer.erase(buffer.begin(), buffer.begin() + linesToDrop);
+    lineBuffer.erase(lineBuffer.begin(), lineBuffer.begin() + linesToDrop);
+    timeBuffer.erase(timeBuffer.begin(), timeBuffer.begin() + linesToDrop);
+    promptBuffer.erase(promptBuffer.begin(), promptBuffer.begin() + linesToDrop);
+    mCursorY -= linesToDrop;
     // We need to adjust the search result line as some lines have now gone
     // away:
-    mpConsole->mCurrentSearchResult = qMax(0, mpConsole->mCurrentSearchResult - mBatchDeleteSize);
+    mpConsole->mCurrentSearchResult = qMax(0, mpConsole->mCurrentSearchResult - linesToDrop);
 
     if (mpConsole->getType() & (TConsole::MainConsole|TConsole::UserWindow|TConsole::SubConsole|TConsole::Buffer)) {
         // Signal to lua subsystem that indexes into the Console will need adjusting
@@ -3020,23 +3112,62 @@ void TBuffer::shrinkBuffer()
         bufferShrinkEvent.mArgumentTypeList.append(ARGUMENT_TYPE_STRING);
         bufferShrinkEvent.mArgumentList.append(mpConsole->mConsoleName);
         bufferShrinkEvent.mArgumentTypeList.append(ARGUMENT_TYPE_STRING);
-        bufferShrinkEvent.mArgumentList.append(QString::number(mBatchDeleteSize));
+        bufferShrinkEvent.mArgumentList.append(QString::number(linesToDrop));
         bufferShrinkEvent.mArgumentTypeList.append(ARGUMENT_TYPE_NUMBER);
         mpHost->raiseEvent(bufferShrinkEvent);
     }
 }
 
-bool TBuffer::deleteLines(int from, int to)
+// The reverse of shrinkBuffer(), puts at least the given number of the most
+// recently archived lines back at the front of the buffer so that they can be
+// shown again, returns how many lines were restored:
+int TBuffer::restoreArchivedLines(const int minimum)
 {
-    if ((from >= 0) && (from < static_cast<int>(buffer.size())) && (from <= to) && (to >= 0) && (to < static_cast<int>(buffer.size()))) {
-        const int delta = to - from + 1;
+    if (!mpConsole || !mpConsole->mpScrollbackArchive || minimum < 1) {
+        return 0;
+    }
 
-        for (int i = from, total = from + delta; i < total; ++i) {
-            lineBuffer.removeAt(i);
-            timeBuffer.removeAt(i);
-            promptBuffer.removeAt(i);
-        }
+    std::vector<TScrollbackArchive::Line> restoredLines = mpConsole->mpScrollbackArchive->takeNewestLines(minimum);
+    const int linesRestored = static_cast<int>(restoredLines.size());
+    if (!linesRestored) {
+        return 0;
+    }
+
+    QStringList restoredText;
+    restoredText.reserve(linesRestored);
+    for (auto it = restoredLines.rbegin(); it != restoredLines.rend(); ++it) {
+        buffer.push_front(std::move(it->mChars));
+        timeBuffer.push_front(it->mTime);
+        promptBuffer.push_front(it->mIsPrompt);
+    }
+    for (auto& restoredLine : restoredLines) {
+        restoredText.append(std::move(restoredLine.mText));
+    }
+    lineBuffer = restoredText + lineBuffer;
+    mCursorY += linesRestored;
+    mpConsole->mCurrentSearchResult += linesRestored;
+
+    if (mpConsole->getType() & (TConsole::MainConsole|TConsole::UserWindow|TConsole::SubConsole|TConsole::Buffer)) {
+        // Signal to lua subsystem that indexes into the Console will need
+        // adjusting the other way to a sysBufferShrinkEvent:
+        TEvent bufferRestoreEvent{};
+        bufferRestoreEvent.mArgumentList.append(QLatin1String("sysBufferRestoreEvent"));
+        bufferRestoreEvent.mArgumentTypeList.append(ARGUMENT_TYPE_STRING);
+        bufferRestoreEvent.mArgumentList.append(mpConsole->mConsoleName);
+        bufferRestoreEvent.mArgumentTypeList.append(ARGUMENT_TYPE_STRING);
+        bufferRestoreEvent.mArgumentList.append(QString::number(linesRestored));
+        bufferRestoreEvent.mArgumentTypeList.append(ARGUMENT_TYPE_NUMBER);
+        mpHost->raiseEvent(bufferRestoreEvent);
+    }
+    return linesRestored;
+}
 
+bool TBuffer::deleteLines(int from, int to)
+{
+    if ((from >= 0) && (from < static_cast<int>(buffer.size())) && (from <= to) && (to >= 0) && (to < static_cast<int>(buffer.size()))) {
+        lineBuffer.erase(lineBuffer.begin() + from, lineBuffer.begin() + to + 1);
+        timeBuffer.erase(timeBuffer.begin() + from, timeBuffer.begin() + to + 1);
+        promptBuffer.erase(promptBuffer.begin() + from, promptBuffer.begin() + to + 1);
         buffer.erase(buffer.begin() + from, buffer.begin() + to + 1);
         return true;
     } else {
@@ -3216,6 +3347,29 @@ bool TBuffer::applyBgColor(const QPoint& P_begin, const QPoint& P_end, const QCo
     return false;
 }
 
+bool TBuffer::applyLineFormat(const int line, const int begin, const int end, const QColor& fgColor, const QColor& bgColor, const TChar::AttributeFlags attributes)
+{
+    if (line < 0 || line >= static_cast<int>(buffer.size()) || begin < 0 || end <= begin) {
+        return false;
+    }
+
+    auto& lineChars = buffer.at(line);
+    const int last = std::min(end, static_cast<int>(lineChars.size()));
+    const bool isFgToBeSet = fgColor.isValid();
+    const bool isBgToBeSet = bgColor.isValid();
+    for (int x = begin; x < last; ++x) {
+        TChar& c = lineChars.at(x);
+        if (isFgToBeSet) {
+            c.mFgColor = fgColor;
+        }
+        if (isBgToBeSet) {
+            c.mBgColor = bgColor;
+        }
+        c.mFlags |= attributes;
+    }
+    return true;
+}
+
 QStringList TBuffer::getEndLines(int n)
 {
     QStringList linesList;
@@ -3272,9 +3426,9 @@ QString TBuffer::bufferToHtml(const bool showTimeStamp /*= false*/, const int ro
     // then we need:
     // <span timestamp format>Timestamp (13 chars)</span><span default>___padding spaces___</span><span first chunk style>first chunk...
     // we will NOT need a closing "</span>"
-    if (showTimeStamp && !timeBuffer.at(row).isEmpty()) {
+    if (showTimeStamp && timeBuffer.at(row) != csmNoTimeStamp) {
         // TODO: formatting according to TTextEdit.cpp: if( i2 < timeOffset ) - needs updating if we allow the colours to be user set:
-        s.append(qsl("<span style=\"color: rgb(200,150,0); background: rgb(22,22,22); \">%1").arg(timeBuffer.at(row).left(timeStampFormat.length())));
+        s.append(qsl("<span style=\"color: rgb(200,150,0); background: rgb(22,22,22); \">%1").arg(timeStampAt(row)));
         // Set the current idea of what the formatting is so we can spot if it
         // changes:
         currentFgColor = QColor(200, 150, 0);
@@ -4328,6 +4482,23 @@ void TBuffer::encodingChanged(const QByteArray& newEncoding)
     }
 }
 
+// Turn the time stamp stored for a line into the text that is displayed for it:
+QString TBuffer::timeStampAt(int lineNumber) const
+{
+    if (lineNumber < 0 || lineNumber >= static_cast<int>(timeBuffer.size())) {
+        return QString();
+    }
+
+    const qint64 timeStamp = timeBuffer.at(lineNumber);
+    if (timeStamp == csmNoTimeStamp) {
+        return QString();
+    }
+    if (timeStamp == csmBlankTimeStamp) {
+        return blankTimeStamp;
+    }
+    return QDateTime::fromMSecsSinceEpoch(timeStamp).toString(timeStampFormat);
+}
+
 // Count the graphemes in a QString - returning its length in terms of those:
 int TBuffer::lengthInGraphemes(const QString& text)
 {
@@ -30,6 +30,7 @@
 #include <QApplication>
 #include <QChar>
 #include <QColor>
+#include <QDateTime>
 #include <QDebug>
 #include <QFont>
 #include <QMap>
@@ -57,6 +58,7 @@ class TConsole;
 class TChar
 {
     friend class TBuffer;
+    friend class TScrollbackArchive;
 
 public:
     enum AttributeFlag {
@@ -131,9 +133,21 @@ public:
     // this:
     explicit TChar(TConsole* pC = nullptr);
     // Another non-default constructor:
-    TChar(const QColor& foreground, const QColor& background, const TChar::AttributeFlags flags = TChar::None, const int linkIndex = 0);
-    // User defined copy-constructor:
-    TChar(const TChar&);
+    TChar(const QColor& foreground, const QColor& background, const TChar::AttributeFlags flags = TChar::None, const int linkIndex = 0)
+    : mFgColor(foreground)
+    , mBgColor(background)
+    , mFlags(flags)
+    , mLinkIndex(linkIndex)
+    {}
+    // User defined copy-constructor - because it is resetting the mIsSelected
+    // flag it is NOT a default copy constructor:
+    TChar(const TChar& copy)
+    : mFgColor(copy.mFgColor)
+    , mBgColor(copy.mBgColor)
+    , mFlags(copy.mFlags)
+    , mIsSelected(false)
+    , mLinkIndex(copy.mLinkIndex)
+    {}
     // Under the rule of three, because we have a user defined copy-constructor,
     // we should also have a destructor and an assignment operator but they can,
     // in this case, be default ones:
@@ -310,6 +324,7 @@ public:
     void addLink(bool, const QString& text, QStringList& command, QStringList& hint, TChar format, QVector<int> luaReference = QVector<int>());
     QString bufferToHtml(const bool showTimeStamp = false, const int row = -1, const int endColumn = -1, const int startColumn = 0,  int spacePadding = 0);
     int size() { return static_cast<int>(buffer.size()); }
+    QString timeStampAt(int lineNumber) const;
     bool isEmpty() const { return buffer.size() == 0; }
     QString& line(int lineNumber);
     int find(int line, const QString& what, int pos);
@@ -319,10 +334,15 @@ public:
     bool replaceInLine(QPoint& start, QPoint& end, const QString& with, TChar& format);
     bool deleteLine(int);
     bool deleteLines(int from, int to);
+    int restoreArchivedLines(const int minimum);
+    int trimToLinesLimit();
     bool applyAttribute(const QPoint& P_begin, const QPoint& P_end, const TChar::AttributeFlags attributes, const bool state);
     bool applyLink(const QPoint& P_begin, const QPoint& P_end, const QStringList& linkFunction, const QStringList& linkHist, QVector<int> luaReference = QVector<int>());
     bool applyFgColor(const QPoint&, const QPoint&, const QColor&);
     bool applyBgColor(const QPoint&, const QPoint&, const QColor&);
+    // Sets all of a format on part of one line in a single pass, an invalid
+    // color is left unchanged and the attributes are only turned on:
+    bool applyLineFormat(const int line, const int begin, const int end, const QColor& fgColor, const QColor& bgColor, const TChar::AttributeFlags attributes);
     void appendBuffer(const TBuffer& chunk);
     bool moveCursor(QPoint& where);
     int getLastLineNumber();
@@ -351,16 +371,23 @@ public:
 
     static int lengthInGraphemes(const QString& text);
 
+    // Values in timeBuffer for lines that have no time stamp at all and for
+    // those that show a row of dashes in place of one:
+    static constexpr qint64 csmNoTimeStamp = -1;
+    static constexpr qint64 csmBlankTimeStamp = -2;
+
 
     std::deque<TChar> bufferLine;
     // stores the text attributes (TChars) that make up each line of text in the buffer
     std::deque<std::deque<TChar>> buffer;
     // stores the actual content of lines
     QStringList lineBuffer;
-    // stores timestamps associated with lines
-    QStringList timeBuffer;
+    // stores the time each line was received as milliseconds since the epoch,
+    // or csmNoTimeStamp/csmBlankTimeStamp - they are only turned into text (by
+    // timeStampAt()) when they are actually shown or logged
+    std::deque<qint64> timeBuffer;
     // stores a boolean whenever the line is a prompt one
-    QList<bool> promptBuffer;
+    std::deque<bool> promptBuffer;
     TLinkStore mLinkStore;
     int mLinesLimit = 10000;
     int mBatchDeleteSize = 1000;
@@ -371,6 +398,7 @@ public:
 
 
 private:
+    bool isOverLinesLimit() const;
     void shrinkBuffer();
     int calculateWrapPosition(int lineNumber, int begin, int end);
     void handleNewLine();
@@ -378,6 +406,7 @@ private:
     bool processGBSequence(const std::string&, bool, bool, size_t, size_t&, bool&);
     bool processBig5Sequence(const std::string&, bool, size_t, size_t&, bool&);
     bool processEUC_KRSequence(const std::string&, bool, size_t, size_t&, bool&);
+    TChar currentTextFormat() const;
     void decodeSGR(const QString&);
     void decodeSGR38(const QStringList&, bool isColonSeparated = true);
     void decodeSGR48(const QStringList&, bool isColonSeparated = true);
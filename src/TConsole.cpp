@@ -31,6 +31,7 @@
 #include "TDebug.h"
 #include "TDockWidget.h"
 #include "TEvent.h"
+#include "THighlighter.h"
 #include "TLabel.h"
 #include "TMainConsole.h"
 #include "TMap.h"
@@ -339,7 +340,8 @@ TConsole::TConsole(Host* pH, const QString& name, const ConsoleType type, QWidge
         mpLineEdit_networkLatency->setSizePolicy(sizePolicy4);
         mpLineEdit_networkLatency->setFocusPolicy(Qt::NoFocus);
         mpLineEdit_networkLatency->setToolTip(utils::richText(tr("<i>N:</i> is the latency of the game server and network (aka ping, in seconds),<br>"
-                                                                 "<i>S:</i> is the system processing time - how long your triggers took to process the last line(s).")));
+                                                                 "<i>S:</i> is the system processing time - how long your triggers took to process the last line(s),<br>"
+                                                                 "<i>Q:</i> (only shown when busy) is the amount of received data still waiting to be processed.")));
         mpLineEdit_networkLatency->setMaximumSize(120, 30);
         mpLineEdit_networkLatency->setMinimumSize(120, 30);
         mpLineEdit_networkLatency->setAutoFillBackground(true);
@@ -997,6 +999,9 @@ void TConsole::scrollDown(int lines)
         mUpperPane->scrollDown(100);                             // needs another scroll to force mIsTailMode
     }
     if (mUpperPane->mIsTailMode) {
+        if (buffer.trimToLinesLimit()) {
+            mUpperPane->updateScrollBar(buffer.mCursorY);
+        }
         mLowerPane->mCursorY = buffer.lineBuffer.size();
         mLowerPane->hide();
 
@@ -1027,6 +1032,11 @@ void TConsole::scrollUp(int lines)
             mpHost->mTutorialForSplitscreenScrollbackAlreadyShown = true;
         }
     }
+    // Page lines back in from the scrollback archive, if there is one, before
+    // the view would run out of lines above it:
+    if (mpScrollbackArchive && buffer.mCursorY - lines < mUpperPane->getScreenHeight()) {
+        restoreArchivedLines(lines + mUpperPane->getScreenHeight());
+    }
     mUpperPane->scrollUp(lines);
     slot_adjustAccessibleNames();
 }
@@ -1240,16 +1250,79 @@ int TConsole::getLineCount()
     return buffer.getLastLineNumber();
 }
 
+// Negative line numbers count back into the scrollback archive, if there is
+// one, from the oldest line still in the buffer:
 QStringList TConsole::getLines(int from, int to)
 {
     QStringList ret;
     const int delta = abs(from - to);
+    const int archivedLineCount = getArchivedLineCount();
     for (int i = 0; i < delta; i++) {
-        ret << buffer.line(from + i);
+        const int lineNumber = from + i;
+        if (lineNumber < 0 && archivedLineCount + lineNumber >= 0) {
+            ret << mpScrollbackArchive->line(archivedLineCount + lineNumber);
+        } else {
+            ret << buffer.line(lineNumber);
+        }
     }
     return ret;
 }
 
+// Brings back at least the given number of lines from the scrollback archive
+// to the top of the buffer and moves everything that refers to a line in the
+// buffer on so that it still refers to the same text, returns the number of
+// lines restored:
+int TConsole::restoreArchivedLines(const int minimum)
+{
+    const int linesRestored = buffer.restoreArchivedLines(minimum);
+    if (!linesRestored) {
+        return 0;
+    }
+
+    mUserCursor.ry() += linesRestored;
+    if (!P_begin.isNull() || !P_end.isNull()) {
+        P_begin.ry() += linesRestored;
+        P_end.ry() += linesRestored;
+    }
+    mUpperPane->adjustForRestoredLines(linesRestored);
+    mLowerPane->adjustForRestoredLines(linesRestored);
+    return linesRestored;
+}
+
+// Returns false if the archive file could not be created:
+bool TConsole::setScrollbackArchiveEnabled(const bool state)
+{
+    if (!state) {
+        // Also removes the file:
+        mpScrollbackArchive.reset();
+        return true;
+    }
+    if (mpScrollbackArchive) {
+        return true;
+    }
+
+    // The archive picks a unique name for its file itself, as console names
+    // need not be valid in file names and two similar ones could otherwise
+    // end up sharing one:
+    auto pArchive = std::make_unique<TScrollbackArchive>(mudlet::getMudletPath(mudlet::profileHomePath, mProfileName));
+    if (!pArchive->isValid()) {
+        return false;
+    }
+    mpScrollbackArchive = std::move(pArchive);
+    return true;
+}
+
+int TConsole::getArchivedLineCount() const
+{
+    return mpScrollbackArchive ? mpScrollbackArchive->lineCount() : 0;
+}
+
+// Both limits are inclusive and count from zero for the oldest archived line:
+QStringList TConsole::getArchivedLines(const int from, const int to)
+{
+    return mpScrollbackArchive ? mpScrollbackArchive->lines(from, to) : QStringList();
+}
+
 void TConsole::selectCurrentLine()
 {
     selectSection(0, buffer.line(mUserCursor.y()).size());
@@ -1510,6 +1583,27 @@ int TConsole::select(const QString& text, int numOfMatch)
     return begin;
 }
 
+// Finds everything the highlighter is looking for in the given line and
+// formats it all in one go - unlike select() and the set...() methods this
+// does not disturb the current selection:
+int TConsole::applyHighlighter(const THighlighter& highlighter, const int lineNumber)
+{
+    if (lineNumber < 0 || lineNumber >= buffer.size()) {
+        return -1;
+    }
+
+    const QVector<THighlighter::Run> runs = highlighter.findRuns(buffer.line(lineNumber));
+    for (const auto& run : runs) {
+        const THighlighter::Format& format = highlighter.format(run.mFormat);
+        buffer.applyLineFormat(lineNumber, run.mBegin, run.mEnd, format.mFgColor, format.mBgColor, format.mAttributes);
+    }
+    if (!runs.isEmpty()) {
+        mUpperPane->forceUpdate();
+        mLowerPane->forceUpdate();
+    }
+    return runs.size();
+}
+
 bool TConsole::selectSection(int from, int to)
 {
     if (mudlet::smDebugMode) {
@@ -1811,24 +1905,47 @@ void TConsole::slot_searchBufferUp()
         return;
     }
 
-    bool found = false;
-    for (int searchY = mCurrentSearchResult - 1; searchY >= 0; --searchY) {
+    const Qt::CaseSensitivity caseSensitivity = (mSearchOptions & SearchOptionCaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    auto highlightMatches = [&](const int searchY) {
+        bool found = false;
         int searchX = -1;
         do {
-            searchX = buffer.lineBuffer[searchY].indexOf(mSearchQuery, searchX + 1, ((mSearchOptions & SearchOptionCaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive));
+            searchX = buffer.lineBuffer[searchY].indexOf(mSearchQuery, searchX + 1, caseSensitivity);
             if (searchX > -1) {
                 buffer.applyAttribute(QPoint(searchX, searchY), QPoint(searchX + mSearchQuery.size(), searchY), TChar::Found, true);
                 found = true;
             }
         } while (searchX > -1);
+        return found;
+    };
+    auto showResult = [&](const int searchY) {
+        // Scrolling up may itself bring back more lines from the archive:
+        const int linesBefore = buffer.size();
+        scrollUp(buffer.mCursorY - searchY - 3);
+        mUpperPane->forceUpdate();
+        mCurrentSearchResult = searchY + buffer.size() - linesBefore;
+    };
 
-        if (found) {
-            scrollUp(buffer.mCursorY - searchY - 3);
-            mUpperPane->forceUpdate();
-            mCurrentSearchResult = searchY;
+    for (int searchY = mCurrentSearchResult - 1; searchY >= 0; --searchY) {
+        if (highlightMatches(searchY)) {
+            showResult(searchY);
             return;
         }
     }
+
+    // Carry on back through the scrollback archive - only the lines from the
+    // one that matched onwards are brought back into the buffer:
+    if (mpScrollbackArchive) {
+        const int archivedLineCount = mpScrollbackArchive->lineCount();
+        const int archivedLine = mpScrollbackArchive->findBackwards(mSearchQuery, caseSensitivity, archivedLineCount);
+        if (archivedLine >= 0) {
+            const int searchY = restoreArchivedLines(archivedLineCount - archivedLine) - (archivedLineCount - archivedLine);
+            if (searchY >= 0 && highlightMatches(searchY)) {
+                showResult(searchY);
+                return;
+            }
+        }
+    }
     print(qsl("%1\n").arg(tr("No search results, sorry!")));
 }
 
@@ -2351,12 +2468,13 @@ void TConsole::handleLinesOverflowEvent(const int lineCount)
 
 void TConsole::clearSplit()
 {
+    mUpperPane->mIsTailMode = true;
+    buffer.trimToLinesLimit();
     mLowerPane->mCursorY = buffer.size();
     mLowerPane->hide();
     buffer.mCursorY = buffer.size();
     mUpperPane->mCursorY = buffer.size();
     mUpperPane->mCursorX = 0;
-    mUpperPane->mIsTailMode = true;
     mUpperPane->updateScreenView();
     mUpperPane->forceUpdate();
 }
@@ -28,6 +28,7 @@
 
 
 #include "TBuffer.h"
+#include "TScrollbackArchive.h"
 
 
 #include "TTextCodec.h"
@@ -48,6 +49,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 
 
 enum class ControlCharacterMode {
@@ -69,6 +71,7 @@ class Host;
 class TTextEdit;
 class TCommandLine;
 class TDockWidget;
+class THighlighter;
 class TLabel;
 class TScrollBox;
 class TSplitter;
@@ -122,6 +125,11 @@ public:
     void resizeEvent(QResizeEvent* event) override;
     void pasteWindow(TBuffer);
     QStringList getLines(int from, int to);
+    bool setScrollbackArchiveEnabled(bool);
+    bool isScrollbackArchiveEnabled() const { return static_cast<bool>(mpScrollbackArchive); }
+    int getArchivedLineCount() const;
+    QStringList getArchivedLines(int from, int to);
+    int restoreArchivedLines(const int minimum);
     int getLineNumber();
     int getLineCount();
     bool deleteLine(int);
@@ -146,6 +154,7 @@ public:
     void echo(const QString&);
     bool moveCursor(int x, int y);
     int select(const QString&, int numOfMatch = 1);
+    int applyHighlighter(const THighlighter&, const int lineNumber);
     std::tuple<bool, QString, int, int> getSelection();
     void deselect();
     bool selectSection(int, int);
@@ -222,6 +231,9 @@ public:
     QPointer<TCommandLine> mpCommandLine;
 
     TBuffer buffer;
+    // Optional cold store for the lines that buffer drops off the front when
+    // it is trimmed, only present when it has been enabled from Lua:
+    std::unique_ptr<TScrollbackArchive> mpScrollbackArchive;
     static const QString cmLuaLineVariable;
     TTextEdit* mUpperPane = nullptr;
     TTextEdit* mLowerPane = nullptr;
@@ -0,0 +1,152 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by The Mudlet Developers - mudlet.org              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "THighlighter.h"
+
+#include <algorithm>
+#include <queue>
+
+int THighlighter::addFormat(const Format& format)
+{
+    mFormats.append(format);
+    return mFormats.size() - 1;
+}
+
+void THighlighter::addString(const QString& text, const int formatIndex, const bool wholeWord)
+{
+    if (text.isEmpty()) {
+        return;
+    }
+
+    int node = 0;
+    for (const QChar c : text) {
+        auto it = mNodes[node].mNext.constFind(c);
+        if (it == mNodes[node].mNext.cend()) {
+            mNodes.emplace_back();
+            const int newNode = static_cast<int>(mNodes.size()) - 1;
+            mNodes[node].mNext.insert(c, newNode);
+            node = newNode;
+        } else {
+            node = it.value();
+        }
+    }
+    if (mNodes[node].mString == -1) {
+        mNodes[node].mString = mStrings.size();
+        mStrings.append({static_cast<int>(text.size()), formatIndex, wholeWord});
+    }
+}
+
+bool THighlighter::addPattern(const QString& pattern, const int formatIndex, const bool wholeWord, QString& errorMessage)
+{
+    QRegularExpression regex(pattern, QRegularExpression::UseUnicodePropertiesOption);
+    if (!regex.isValid()) {
+        errorMessage = regex.errorString();
+        return false;
+    }
+    regex.optimize();
+    mPatterns.append({regex, formatIndex, wholeWord});
+    return true;
+}
+
+void THighlighter::compile()
+{
+    // Work out the fail links breadth first so that every node's fail target,
+    // being shallower, is already complete when it is needed:
+    std::queue<int> pending;
+    for (const int child : qAsConst(mNodes[0].mNext)) {
+        mNodes[child].mFail = 0;
+        pending.push(child);
+    }
+    while (!pending.empty()) {
+        const int node = pending.front();
+        pending.pop();
+        for (auto it = mNodes[node].mNext.cbegin(), end = mNodes[node].mNext.cend(); it != end; ++it) {
+            const QChar c = it.key();
+            const int child = it.value();
+            int fail = mNodes[node].mFail;
+            while (fail && !mNodes[fail].mNext.contains(c)) {
+                fail = mNodes[fail].mFail;
+            }
+            mNodes[child].mFail = mNodes[fail].mNext.value(c, 0);
+            const Node& failNode = mNodes[mNodes[child].mFail];
+            mNodes[child].mOutputLink = (failNode.mString != -1) ? mNodes[child].mFail : failNode.mOutputLink;
+            pending.push(child);
+        }
+    }
+}
+
+bool THighlighter::isWordBoundary(const QString& text, const int begin, const int end)
+{
+    auto isWordChar = [](const QChar c) { return c.isLetterOrNumber() || c == QLatin1Char('_'); };
+    return (begin == 0 || !isWordChar(text.at(begin - 1))) && (end >= text.size() || !isWordChar(text.at(end)));
+}
+
+QVector<THighlighter::Run> THighlighter::findRuns(const QString& text) const
+{
+    QVector<Run> candidates;
+    if (text.isEmpty()) {
+        return candidates;
+    }
+
+    int node = 0;
+    for (int i = 0, total = text.size(); i < total; ++i) {
+        const QChar c = text.at(i);
+        while (node && !mNodes[node].mNext.contains(c)) {
+            node = mNodes[node].mFail;
+        }
+        node = mNodes[node].mNext.value(c, 0);
+        int output = (mNodes[node].mString != -1) ? node : mNodes[node].mOutputLink;
+        while (output != -1) {
+            const StringEntry& entry = mStrings.at(mNodes[output].mString);
+            const int begin = i + 1 - entry.mLength;
+            if (!entry.mWholeWord || isWordBoundary(text, begin, i + 1)) {
+                candidates.append({begin, i + 1, entry.mFormat});
+            }
+            output = mNodes[output].mOutputLink;
+        }
+    }
+
+    for (const auto& pattern : mPatterns) {
+        auto matches = pattern.mRegex.globalMatch(text);
+        while (matches.hasNext()) {
+            const auto match = matches.next();
+            const int begin = match.capturedStart();
+            const int end = match.capturedEnd();
+            if (end > begin && (!pattern.mWholeWord || isWordBoundary(text, begin, end))) {
+                candidates.append({begin, end, pattern.mFormat});
+            }
+        }
+    }
+
+    // Keep the leftmost (and then longest) of any that overlap; the sort is
+    // stable so that strings win over patterns, and earlier patterns over
+    // later ones, for the very same span:
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Run& a, const Run& b) {
+        return a.mBegin < b.mBegin || (a.mBegin == b.mBegin && a.mEnd > b.mEnd);
+    });
+    QVector<Run> runs;
+    int covered = 0;
+    for (const auto& candidate : qAsConst(candidates)) {
+        if (candidate.mBegin >= covered) {
+            runs.append(candidate);
+            covered = candidate.mEnd;
+        }
+    }
+    return runs;
+}
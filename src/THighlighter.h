@@ -0,0 +1,106 @@
+#ifndef MUDLET_THIGHLIGHTER_H
+#define MUDLET_THIGHLIGHTER_H
+
+/***************************************************************************
+ *   Copyright (C) 2026 by The Mudlet Developers - mudlet.org              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "TBuffer.h"
+
+#include "pre_guard.h"
+#include <QColor>
+#include <QHash>
+#include <QRegularExpression>
+#include <QString>
+#include <QVector>
+#include "post_guard.h"
+
+#include <vector>
+
+// A precompiled set of literal strings and regular expressions, each with a
+// format, that can be found in a line of text in a single pass. All the
+// literal strings are matched together with an Aho-Corasick automaton so the
+// cost of searching a line does not grow with the number of strings:
+class THighlighter
+{
+public:
+    struct Format
+    {
+        // An invalid color leaves the existing one unchanged:
+        QColor mFgColor;
+        QColor mBgColor;
+        // These are only ever turned on:
+        TChar::AttributeFlags mAttributes = TChar::None;
+    };
+
+    // The characters from mBegin up to (but not including) mEnd are to be
+    // given the format with index mFormat:
+    struct Run
+    {
+        int mBegin = 0;
+        int mEnd = 0;
+        int mFormat = 0;
+    };
+
+    int addFormat(const Format&);
+    // Only the first format given for any particular string is used:
+    void addString(const QString&, const int formatIndex, const bool wholeWord);
+    // Returns false and sets errorMessage if the pattern is not valid:
+    bool addPattern(const QString&, const int formatIndex, const bool wholeWord, QString& errorMessage);
+    // Must be called after adding strings and before using findRuns():
+    void compile();
+
+    // Overlapping matches are resolved by taking the leftmost one, and the
+    // longest if there is more than one starting at the same place:
+    QVector<Run> findRuns(const QString&) const;
+    const Format& format(const int index) const { return mFormats.at(index); }
+
+private:
+    struct Node
+    {
+        QHash<QChar, int> mNext;
+        int mFail = 0;
+        // Index into mStrings of the string that ends here, or -1:
+        int mString = -1;
+        // The nearest node along the chain of fail links that ends a string:
+        int mOutputLink = -1;
+    };
+
+    struct StringEntry
+    {
+        int mLength = 0;
+        int mFormat = 0;
+        bool mWholeWord = false;
+    };
+
+    struct PatternEntry
+    {
+        QRegularExpression mRegex;
+        int mFormat = 0;
+        bool mWholeWord = false;
+    };
+
+    static bool isWordBoundary(const QString&, const int begin, const int end);
+
+    std::vector<Node> mNodes{1};
+    QVector<StringEntry> mStrings;
+    QVector<PatternEntry> mPatterns;
+    QVector<Format> mFormats;
+};
+
+#endif // MUDLET_THIGHLIGHTER_H
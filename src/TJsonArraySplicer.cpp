@@ -0,0 +1,100 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by The Mudlet Developers - mudlet.org              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "TJsonArraySplicer.h"
+
+#include "utils.h"
+
+#include "pre_guard.h"
+#include <QJsonDocument>
+#include <QUuid>
+#include "post_guard.h"
+
+TJsonArraySplicer::TJsonArraySplicer(QIODevice& device, const QString& key)
+: mDevice(device)
+, mKey(key)
+, mPlaceholder(qsl("@%1@%2@").arg(key, QUuid::createUuid().toString(QUuid::WithoutBraces)))
+{
+}
+
+void TJsonArraySplicer::insertPlaceholder(QJsonObject& object) const
+{
+    object.insert(mKey, mPlaceholder);
+}
+
+bool TJsonArraySplicer::begin(const QJsonObject& object)
+{
+    const QByteArray text{QJsonDocument(object).toJson(QJsonDocument::Indented)};
+    const QByteArray marker{'"' + mPlaceholder.toUtf8() + '"'};
+    const auto position = text.indexOf(marker);
+    if (position < 0) {
+        return false;
+    }
+
+    mDevice.write(text.constData(), position);
+    mDevice.write("[\n");
+    mTail = text.mid(position + marker.size());
+    mHasElements = false;
+    return true;
+}
+
+void TJsonArraySplicer::appendElement(const QByteArray& elementText)
+{
+    if (mHasElements) {
+        mDevice.write(",\n");
+    }
+    mHasElements = true;
+    mDevice.write(elementText);
+}
+
+void TJsonArraySplicer::end()
+{
+    // This matches what QJsonDocument produces for the close of an array one
+    // level in, whether or not it is empty:
+    mDevice.write(mHasElements ? "\n    ]" : "    ]");
+    mDevice.write(mTail);
+    mTail.clear();
+}
+
+// Renders an object as QJsonDocument::Indented would as an element of such an
+// array, i.e. with an extra two levels (eight spaces) of indentation and no
+// trailing newline. A raw newline is always escaped inside a JSON string value
+// so every line can safely be indented:
+QByteArray TJsonArraySplicer::elementText(const QJsonObject& object)
+{
+    const QByteArray text{QJsonDocument(object).toJson(QJsonDocument::Indented)};
+    const QByteArray indent(8, ' ');
+    QByteArray result;
+    result.reserve(text.size() + text.count('\n') * indent.size());
+    qsizetype lineStart = 0;
+    while (lineStart < text.size()) {
+        qsizetype lineEnd = text.indexOf('\n', lineStart);
+        if (lineEnd < 0) {
+            lineEnd = text.size();
+        }
+        if (lineStart) {
+            result.append('\n');
+        }
+        result.append(indent);
+        result.append(text.constData() + lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+    }
+    return result;
+}
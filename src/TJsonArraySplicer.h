@@ -0,0 +1,58 @@
+#ifndef MUDLET_TJSONARRAYSPLICER_H
+#define MUDLET_TJSONARRAYSPLICER_H
+
+/***************************************************************************
+ *   Copyright (C) 2026 by The Mudlet Developers - mudlet.org              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "pre_guard.h"
+#include <QByteArray>
+#include <QIODevice>
+#include <QJsonObject>
+#include <QString>
+#include "post_guard.h"
+
+// Writes a JSON object to a device exactly as QJsonDocument::Indented would,
+// except that the elements of one of its top level arrays of objects are
+// given one at a time, so that the whole array never has to be held at once.
+// Usage: insertPlaceholder() into the otherwise complete object, begin() with
+// it, appendElement() with each element's elementText() in turn and end():
+class TJsonArraySplicer
+{
+public:
+    TJsonArraySplicer(QIODevice& device, const QString& key);
+
+    void insertPlaceholder(QJsonObject&) const;
+    // Returns false, having written nothing, if the placeholder is missing:
+    bool begin(const QJsonObject&);
+    void appendElement(const QByteArray&);
+    void end();
+
+    // Only uses its argument so can be run on any thread:
+    static QByteArray elementText(const QJsonObject&);
+
+private:
+    QIODevice& mDevice;
+    QString mKey;
+    QString mPlaceholder;
+    // The text that follows the array:
+    QByteArray mTail;
+    bool mHasElements = false;
+};
+
+#endif // MUDLET_TJSONARRAYSPLICER_H
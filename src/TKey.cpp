@@ -66,33 +66,20 @@ void TKey::setName(const QString& name)
     mpHost->getKeyUnit()->mLookupTable.insert(name, this);
 }
 
-bool TKey::match(const Qt::Key key, const Qt::KeyboardModifiers modifier, const bool isToMatchAll)
+void TKey::setKeyCode(const Qt::Key code)
 {
-    bool isAMatch = false;
-    if (isActive()) {
-        if (!isFolder()) {
-            if ((mKeyCode == key) && (mKeyModifier == modifier)) {
-                execute();
-                if (isToMatchAll) {
-                    isAMatch = true;
-                } else {
-                    return true;
-                }
-            }
-        }
-
-        for (auto childKey : *mpMyChildrenList) {
-            if (childKey->match(key, modifier, isToMatchAll)) {
-                if (isToMatchAll) {
-                    isAMatch = true;
-                } else {
-                    return true;
-                }
-            }
-        }
+    mKeyCode = code;
+    if (mpHost) {
+        mpHost->getKeyUnit()->invalidateDispatchIndex();
     }
+}
 
-    return isAMatch;
+void TKey::setKeyModifiers(const Qt::KeyboardModifiers code)
+{
+    mKeyModifier = code;
+    if (mpHost) {
+        mpHost->getKeyUnit()->invalidateDispatchIndex();
+    }
 }
 
 
@@ -181,6 +168,7 @@ bool TKey::compileScript()
 
 void TKey::execute()
 {
+    const TProfilerSample profilerSample(mpHost->mProfiler, TProfiler::Key, mID, mName, TProfilerSample::Run);
     if (!mCommand.isEmpty()) {
         mpHost->send(mCommand);
     }
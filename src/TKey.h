@@ -51,10 +51,10 @@ public:
     QString getName() const { return mName; }
     void setName(const QString & name);
     Qt::Key getKeyCode() const { return mKeyCode; }
-    void setKeyCode(const Qt::Key code) { mKeyCode = code; }
+    void setKeyCode(const Qt::Key code);
     void setKeyCode(const int codeNumber) { setKeyCode(static_cast<Qt::Key>(codeNumber)); }
     Qt::KeyboardModifiers getKeyModifiers() const { return mKeyModifier; }
-    void setKeyModifiers(const Qt::KeyboardModifiers code) { mKeyModifier = code; }
+    void setKeyModifiers(const Qt::KeyboardModifiers code);
     void setKeyModifiers(const int codeNumber) { setKeyModifiers(static_cast<Qt::KeyboardModifiers>(codeNumber)); }
     void enableKey(const QString& name);
     void disableKey(const QString& name);
@@ -66,7 +66,6 @@ public:
     void setCommand(QString command) { mCommand = command; }
     QString getCommand() const { return mCommand; }
 
-    bool match(const Qt::Key, const Qt::KeyboardModifiers, const bool);
     bool registerKey();
 
     bool exportItem = true;
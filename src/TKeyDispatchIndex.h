@@ -0,0 +1,109 @@
+#ifndef MUDLET_TKEYDISPATCHINDEX_H
+#define MUDLET_TKEYDISPATCHINDEX_H
+
+/***************************************************************************
+ *   Copyright (C) 2026 by The Mudlet Developers - mudlet.org              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "pre_guard.h"
+#include <QHash>
+#include <QtGlobal>
+#include "post_guard.h"
+
+#include <vector>
+
+// Groups the key bindings in a set of trees by their key and modifiers so that
+// a key press only has to look at the bindings that use that combination.
+// Each group is in the order that a walk down the trees reaches them, which is
+// the order that they fire in. Whether a binding is a folder, or it or any of
+// its ancestors is inactive, is only checked when a key is pressed so that
+// enabling and disabling bindings does not need a rebuild - only adding,
+// removing or moving them, or changing their key or modifiers, does.
+//
+// KeyType needs getKeyCode(), getKeyModifiers(), getChildrenList(),
+// isFolder(), isActive() and ancestorsActive() like TKey has:
+template <typename KeyType>
+class TKeyDispatchIndex
+{
+public:
+    void invalidate() { mIsDirty = true; }
+    bool isDirty() const { return mIsDirty; }
+
+    // Calls fire(...) on each binding that matches, in order, stopping after
+    // the first unless runAllMatches is set, and returns whether any did:
+    template <typename RootList, typename Function>
+    bool dispatch(const RootList& rootNodes, const Qt::Key key, const Qt::KeyboardModifiers modifiers, const bool runAllMatches, Function fire)
+    {
+        if (mIsDirty) {
+            rebuild(rootNodes);
+        }
+
+        const auto itCandidates = mIndex.constFind(indexKey(key, modifiers));
+        if (itCandidates == mIndex.cend()) {
+            return false;
+        }
+
+        // Work on a copy as a key binding's script could add or remove others:
+        const std::vector<KeyType*> candidates = itCandidates.value();
+        bool isMatchFound = false;
+        for (auto pKey : candidates) {
+            if (pKey->isFolder() || !pKey->isActive() || !pKey->ancestorsActive()) {
+                continue;
+            }
+
+            fire(pKey);
+            if (!runAllMatches) {
+                return true;
+            }
+
+            isMatchFound = true;
+        }
+
+        return isMatchFound;
+    }
+
+private:
+    static quint64 indexKey(const Qt::Key key, const Qt::KeyboardModifiers modifiers)
+    {
+        return (static_cast<quint64>(static_cast<quint32>(key)) << 32) | static_cast<quint32>(modifiers);
+    }
+
+    template <typename RootList>
+    void rebuild(const RootList& rootNodes)
+    {
+        mIndex.clear();
+        for (auto pKey : rootNodes) {
+            add(pKey);
+        }
+        mIsDirty = false;
+    }
+
+    void add(KeyType* pKey)
+    {
+        mIndex[indexKey(pKey->getKeyCode(), pKey->getKeyModifiers())].push_back(pKey);
+        for (auto pChild : *pKey->getChildrenList()) {
+            add(pChild);
+        }
+    }
+
+
+    QHash<quint64, std::vector<KeyType*>> mIndex;
+    bool mIsDirty = true;
+};
+
+#endif // MUDLET_TKEYDISPATCHINDEX_H
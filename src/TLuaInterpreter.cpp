@@ -2209,10 +2209,10 @@ int TLuaInterpreter::getTimestamp(lua_State* L)
 
     const Host& host = getHostFromLua(L);
     if (name.isEmpty()) {
-        if (luaLine > 0 && luaLine < host.mpConsole->buffer.timeBuffer.size()) {
+        if (luaLine > 0 && luaLine < static_cast<qint64>(host.mpConsole->buffer.timeBuffer.size())) {
             // CHECK: Lua starts counting at 1 but we are indexing into a C/C++
             // structure but the previous code did not accept a zero line number
-            lua_pushstring(L, host.mpConsole->buffer.timeBuffer.at(luaLine).toUtf8().constData());
+            lua_pushstring(L, host.mpConsole->buffer.timeStampAt(luaLine).toUtf8().constData());
         } else {
             lua_pushstring(L, "getTimestamp: invalid line number");
         }
@@ -2222,8 +2222,8 @@ int TLuaInterpreter::getTimestamp(lua_State* L)
         if (!pC) {
             return warnArgumentValue(L, __func__, qsl("mini console, user window or buffer '%1' not found").arg(name));
         }
-        if (luaLine > 0 && luaLine < pC->buffer.timeBuffer.size()) {
-            lua_pushstring(L, pC->buffer.timeBuffer.at(luaLine).toUtf8().constData());
+        if (luaLine > 0 && luaLine < static_cast<qint64>(pC->buffer.timeBuffer.size())) {
+            lua_pushstring(L, pC->buffer.timeStampAt(luaLine).toUtf8().constData());
         } else {
             lua_pushstring(L, "getTimestamp: invalid line number");
         }
@@ -3862,23 +3862,54 @@ void TLuaInterpreter::setChannel102Table(int& var, int& arg)
 // No documentation available in wiki - internal function
 void TLuaInterpreter::setMatches(lua_State* L)
 {
-    if (!mCaptureGroupList.empty()) {
-        lua_newtable(L);
+    if (mCaptureGroupList.empty()) {
+        return;
+    }
 
-        // set values
-        int i = 1; // Lua indexes start with 1 as a general convention
-        for (auto it = mCaptureGroupList.begin(); it != mCaptureGroupList.end(); it++, i++) {
-            // if ((*it).length() < 1) continue; //have empty capture groups to be undefined keys i.e. matches[emptyCapGroupNumber] = nil otherwise it's = "" i.e. an empty string
-            lua_pushnumber(L, i);
-            lua_pushstring(L, (*it).c_str());
-            lua_settable(L, -3);
-        }
-        for (auto [name, capture] : mCapturedNameGroups) {
-            lua_pushstring(L, name.toUtf8().constData());
-            lua_pushstring(L, capture.toUtf8().constData());
-            lua_settable(L, -3);
-        }
-        lua_setglobal(L, "matches");
+    pushMatchesTable(L, mCaptureGroupList, mCapturedNameGroups);
+    lua_setglobal(L, "matches");
+}
+
+// No documentation available in wiki - internal function
+void TLuaInterpreter::setMultiMatches(lua_State* L)
+{
+    if (mMultiCaptureGroupList.empty()) {
+        return;
+    }
+
+    pushMultiMatchesTable(L, mMultiCaptureGroupList, mMultiCaptureNameGroups);
+    lua_setglobal(L, "multimatches");
+}
+
+// No documentation available in wiki - internal function
+// Pushes a table holding the numbered captures followed by the named ones:
+void TLuaInterpreter::pushMatchesTable(lua_State* L, const std::list<std::string>& captures, const QVector<QPair<QString, QString>>& nameGroups)
+{
+    lua_createtable(L, static_cast<int>(captures.size()), nameGroups.size());
+    int i = 1; // Lua indexes start with 1 as a general convention
+    for (const auto& capture : captures) {
+        // if (capture.length() < 1) continue; //have empty capture groups to be undefined keys i.e. matches[emptyCapGroupNumber] = nil otherwise it's = "" i.e. an empty string
+        lua_pushlstring(L, capture.data(), capture.size());
+        lua_rawseti(L, -2, i++);
+    }
+    for (const auto& [name, capture] : nameGroups) {
+        const QByteArray nameUtf8 = name.toUtf8();
+        const QByteArray captureUtf8 = capture.toUtf8();
+        lua_pushlstring(L, nameUtf8.constData(), nameUtf8.size());
+        lua_pushlstring(L, captureUtf8.constData(), captureUtf8.size());
+        lua_rawset(L, -3);
+    }
+}
+
+// No documentation available in wiki - internal function
+// multimatches{ trigger_idx{ table_matches{ ... } } }
+void TLuaInterpreter::pushMultiMatchesTable(lua_State* L, const std::list<std::list<std::string>>& captureLists, const QVector<QVector<QPair<QString, QString>>>& nameGroups)
+{
+    lua_createtable(L, static_cast<int>(captureLists.size()), 0);
+    int k = 1; // Lua indexes start with 1 as a general convention
+    for (const auto& captures : captureLists) {
+        pushMatchesTable(L, captures, nameGroups.value(k - 1));
+        lua_rawseti(L, -2, k++);
     }
 }
 
@@ -4173,28 +4204,7 @@ bool TLuaInterpreter::callMulti(const QString& function, const QString& mName)
 {
     lua_State* L = pGlobalLua;
 
-    if (!mMultiCaptureGroupList.empty()) {
-        int k = 1;       // Lua indexes start with 1 as a general convention
-        lua_newtable(L); //multimatches
-        for (auto mit = mMultiCaptureGroupList.begin(); mit != mMultiCaptureGroupList.end(); mit++, k++) {
-            // multimatches{ trigger_idx{ table_matches{ ... } } }
-            lua_pushnumber(L, k);
-            lua_newtable(L); //regex-value => table matches
-            int i = 1;       // Lua indexes start with 1 as a general convention
-            for (auto it = (*mit).begin(); it != (*mit).end(); it++, i++) {
-                lua_pushnumber(L, i);
-                lua_pushstring(L, (*it).c_str());
-                lua_settable(L, -3); //match in matches
-            }
-            for (auto [name, capture] : mMultiCaptureNameGroups.value(k - 1)) {
-                lua_pushstring(L, name.toUtf8().constData());
-                lua_pushstring(L, capture.toUtf8().constData());
-                lua_settable(L, -3);
-            }
-            lua_settable(L, -3); //matches in regex
-        }
-        lua_setglobal(L, "multimatches");
-    }
+    setMultiMatches(L);
 
     lua_getglobal(L, function.toUtf8().constData());
     const int error = lua_pcall(L, 0, LUA_MULTRET, 0);
@@ -4228,23 +4238,7 @@ std::pair<bool, bool> TLuaInterpreter::callMultiReturnBool(const QString& functi
 
     bool returnValue = false;
 
-    if (!mMultiCaptureGroupList.empty()) {
-        int k = 1;       // Lua indexes start with 1 as a general convention
-        lua_newtable(L); //multimatches
-        for (auto mit = mMultiCaptureGroupList.begin(); mit != mMultiCaptureGroupList.end(); mit++, k++) {
-            // multimatches{ trigger_idx{ table_matches{ ... } } }
-            lua_pushnumber(L, k);
-            lua_newtable(L); //regex-value => table matches
-            int i = 1;       // Lua indexes start with 1 as a general convention
-            for (auto it = (*mit).begin(); it != (*mit).end(); it++, i++) {
-                lua_pushnumber(L, i);
-                lua_pushstring(L, (*it).c_str());
-                lua_settable(L, -3); //match in matches
-            }
-            lua_settable(L, -3); //matches in regex
-        }
-        lua_setglobal(L, "multimatches");
-    }
+    setMultiMatches(L);
 
     lua_getglobal(L, function.toUtf8().constData());
     const int error = lua_pcall(L, 0, LUA_MULTRET, 0);
@@ -5008,6 +5002,9 @@ void TLuaInterpreter::initLuaGlobals()
     lua_register(pGlobalLua, "getNetworkLatency", TLuaInterpreter::getNetworkLatency);
     lua_register(pGlobalLua, "createMiniConsole", TLuaInterpreter::createMiniConsole);
     lua_register(pGlobalLua, "createScrollBox", TLuaInterpreter::createScrollBox);
+    lua_register(pGlobalLua, "createHighlighter", TLuaInterpreter::createHighlighter);
+    lua_register(pGlobalLua, "applyHighlighter", TLuaInterpreter::applyHighlighter);
+    lua_register(pGlobalLua, "deleteHighlighter", TLuaInterpreter::deleteHighlighter);
     lua_register(pGlobalLua, "createLabel", TLuaInterpreter::createLabel);
     lua_register(pGlobalLua, "deleteLabel", TLuaInterpreter::deleteLabel);
     lua_register(pGlobalLua, "setLabelToolTip", TLuaInterpreter::setLabelToolTip);
@@ -5056,6 +5053,8 @@ void TLuaInterpreter::initLuaGlobals()
     lua_register(pGlobalLua, "getImageSize", TLuaInterpreter::getImageSize);
     lua_register(pGlobalLua, "moveWindow", TLuaInterpreter::moveWindow);
     lua_register(pGlobalLua, "setWindow", TLuaInterpreter::setWindow);
+    lua_register(pGlobalLua, "setWindowGeometry", TLuaInterpreter::setWindowGeometry);
+    lua_register(pGlobalLua, "setGaugeValue", TLuaInterpreter::setGaugeValue);
     lua_register(pGlobalLua, "openMapWidget", TLuaInterpreter::openMapWidget);
     lua_register(pGlobalLua, "closeMapWidget", TLuaInterpreter::closeMapWidget);
     lua_register(pGlobalLua, "setTextFormat", TLuaInterpreter::setTextFormat);
@@ -5118,6 +5117,10 @@ void TLuaInterpreter::initLuaGlobals()
     lua_register(pGlobalLua, "getConsoleBufferSize", TLuaInterpreter::getConsoleBufferSize);
     lua_register(pGlobalLua, "setConsoleBufferSize", TLuaInterpreter::setConsoleBufferSize);
     lua_register(pGlobalLua, "enableScrollBar", TLuaInterpreter::enableScrollBar);
+    lua_register(pGlobalLua, "enableScrollbackArchive", TLuaInterpreter::enableScrollbackArchive);
+    lua_register(pGlobalLua, "disableScrollbackArchive", TLuaInterpreter::disableScrollbackArchive);
+    lua_register(pGlobalLua, "getArchivedLineCount", TLuaInterpreter::getArchivedLineCount);
+    lua_register(pGlobalLua, "getArchivedLines", TLuaInterpreter::getArchivedLines);
     lua_register(pGlobalLua, "disableScrollBar", TLuaInterpreter::disableScrollBar);
     lua_register(pGlobalLua, "enableHorizontalScrollBar", TLuaInterpreter::enableHorizontalScrollBar);
     lua_register(pGlobalLua, "disableHorizontalScrollBar", TLuaInterpreter::disableHorizontalScrollBar);
@@ -5212,6 +5215,10 @@ void TLuaInterpreter::initLuaGlobals()
     lua_register(pGlobalLua, "setRoomUserData", TLuaInterpreter::setRoomUserData);
     lua_register(pGlobalLua, "searchRoomUserData", TLuaInterpreter::searchRoomUserData);
     lua_register(pGlobalLua, "getRoomsByPosition", TLuaInterpreter::getRoomsByPosition);
+    lua_register(pGlobalLua, "getRoomsData", TLuaInterpreter::getRoomsData);
+    lua_register(pGlobalLua, "setRoomsData", TLuaInterpreter::setRoomsData);
+    lua_register(pGlobalLua, "beginMapUpdate", TLuaInterpreter::beginMapUpdate);
+    lua_register(pGlobalLua, "endMapUpdate", TLuaInterpreter::endMapUpdate);
     lua_register(pGlobalLua, "clearRoomUserData", TLuaInterpreter::clearRoomUserData);
     lua_register(pGlobalLua, "clearRoomUserDataItem", TLuaInterpreter::clearRoomUserDataItem);
     lua_register(pGlobalLua, "downloadFile", TLuaInterpreter::downloadFile);
@@ -5432,6 +5439,9 @@ void TLuaInterpreter::initLuaGlobals()
     lua_register(pGlobalLua, "deleteMap", TLuaInterpreter::deleteMap);
     lua_register(pGlobalLua, "windowType", TLuaInterpreter::windowType);
     lua_register(pGlobalLua, "getProfileStats", TLuaInterpreter::getProfileStats);
+    lua_register(pGlobalLua, "getProfilerStats", TLuaInterpreter::getProfilerStats);
+    lua_register(pGlobalLua, "setProfilerEnabled", TLuaInterpreter::setProfilerEnabled);
+    lua_register(pGlobalLua, "resetProfilerStats", TLuaInterpreter::resetProfilerStats);
     lua_register(pGlobalLua, "getBackgroundColor", TLuaInterpreter::getBackgroundColor);
     lua_register(pGlobalLua, "getLabelStyleSheet", TLuaInterpreter::getLabelStyleSheet);
     lua_register(pGlobalLua, "getLabelSizeHint", TLuaInterpreter::getLabelSizeHint);
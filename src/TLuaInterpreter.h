@@ -230,6 +230,10 @@ public:
     static int sendSocket(lua_State*);
     static int openUrl(lua_State*);
     static int getRoomsByPosition(lua_State*);
+    static int getRoomsData(lua_State*);
+    static int beginMapUpdate(lua_State*);
+    static int endMapUpdate(lua_State*);
+    static int setRoomsData(lua_State*);
     static int getRoomEnv(lua_State*);
     static int downloadFile(lua_State*);
     static int setRoomUserData(lua_State*);
@@ -382,6 +386,9 @@ public:
     static int getStopWatchBrokenDownTime(lua_State*);
     static int createMiniConsole(lua_State*);
     static int createScrollBox(lua_State*);
+    static int createHighlighter(lua_State*);
+    static int applyHighlighter(lua_State*);
+    static int deleteHighlighter(lua_State*);
     static int createLabel(lua_State*);
     static int createLabelMainWindow(lua_State*, const QString& labelName);
     static int createLabelUserWindow(lua_State*, const QString& windowName, const QString& labelName);
@@ -391,6 +398,8 @@ public:
     static int setLabelCustomCursor(lua_State*);
     static int moveWindow(lua_State*);
     static int setWindow(lua_State*);
+    static int setWindowGeometry(lua_State*);
+    static int setGaugeValue(lua_State*);
     static int openMapWidget(lua_State*);
     static int closeMapWidget(lua_State*);
     static int setTextFormat(lua_State*);
@@ -471,6 +480,10 @@ public:
     static int getConsoleBufferSize(lua_State*);
     static int setConsoleBufferSize(lua_State*);
     static int enableScrollBar(lua_State*);
+    static int enableScrollbackArchive(lua_State*);
+    static int disableScrollbackArchive(lua_State*);
+    static int getArchivedLineCount(lua_State*);
+    static int getArchivedLines(lua_State*);
     static int disableScrollBar(lua_State*);
     static int disableHorizontalScrollBar(lua_State*);
     static int enableHorizontalScrollBar(lua_State*);
@@ -652,6 +665,9 @@ public:
     static int deleteMap(lua_State*);
     static int windowType(lua_State*);
     static int getProfileStats(lua_State*);
+    static int getProfilerStats(lua_State*);
+    static int setProfilerEnabled(lua_State*);
+    static int resetProfilerStats(lua_State*);
     static int getBackgroundColor(lua_State*);
     static int getLabelStyleSheet(lua_State*);
     static int getLabelSizeHint(lua_State*);
@@ -765,6 +781,9 @@ private:
     std::pair<bool, QString> validateLuaCodeParam(int index);
     QByteArray encodeBytes(const char*);
     void setMatches(lua_State*);
+    void setMultiMatches(lua_State*);
+    static void pushMatchesTable(lua_State*, const std::list<std::string>&, const QVector<QPair<QString, QString>>&);
+    static void pushMultiMatchesTable(lua_State*, const std::list<std::list<std::string>>&, const QVector<QVector<QPair<QString, QString>>>&);
     void setupLanguageData();
     QString readScriptFile(const QString& path) const;
     void handleHttpOK(QNetworkReply*);
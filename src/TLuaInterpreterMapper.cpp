@@ -90,6 +90,117 @@ static bool isMain(const QString& name)
     return false;
 }
 
+// The room details that getRoomsData(...) and setRoomsData(...) handle; a
+// single user data item can also be fetched as "userData.<key>":
+enum class RoomDataField { Name, Area, X, Y, Z, Env, Weight, Symbol, Locked, Exits, UserData, UserDataItem };
+
+struct RoomDataFieldRequest
+{
+    RoomDataField field;
+    QByteArray name;
+    QString userDataKey;
+};
+
+static const QHash<QString, RoomDataField> scmRoomDataFields{
+        {qsl("name"), RoomDataField::Name},
+        {qsl("area"), RoomDataField::Area},
+        {qsl("x"), RoomDataField::X},
+        {qsl("y"), RoomDataField::Y},
+        {qsl("z"), RoomDataField::Z},
+        {qsl("env"), RoomDataField::Env},
+        {qsl("weight"), RoomDataField::Weight},
+        {qsl("symbol"), RoomDataField::Symbol},
+        {qsl("locked"), RoomDataField::Locked},
+        {qsl("exits"), RoomDataField::Exits},
+        {qsl("userData"), RoomDataField::UserData}};
+
+// No documentation available in wiki - internal function
+static void pushRoomExits(lua_State* L, const TRoom* pR)
+{
+    const std::pair<const char*, int> exits[]{{"north", pR->getNorth()},
+                                              {"northwest", pR->getNorthwest()},
+                                              {"northeast", pR->getNortheast()},
+                                              {"south", pR->getSouth()},
+                                              {"southwest", pR->getSouthwest()},
+                                              {"southeast", pR->getSoutheast()},
+                                              {"west", pR->getWest()},
+                                              {"east", pR->getEast()},
+                                              {"up", pR->getUp()},
+                                              {"down", pR->getDown()},
+                                              {"in", pR->getIn()},
+                                              {"out", pR->getOut()}};
+    lua_newtable(L);
+    for (const auto& [direction, exitRoomId] : exits) {
+        if (exitRoomId != -1) {
+            lua_pushstring(L, direction);
+            lua_pushnumber(L, exitRoomId);
+            lua_settable(L, -3);
+        }
+    }
+}
+
+// No documentation available in wiki - internal function
+static void pushRoomDataField(lua_State* L, const TRoom* pR, const RoomDataFieldRequest& request)
+{
+    switch (request.field) {
+    case RoomDataField::Name:
+        lua_pushstring(L, pR->name.toUtf8().constData());
+        break;
+    case RoomDataField::Area:
+        lua_pushnumber(L, pR->getArea());
+        break;
+    case RoomDataField::X:
+        lua_pushnumber(L, pR->x);
+        break;
+    case RoomDataField::Y:
+        lua_pushnumber(L, pR->y);
+        break;
+    case RoomDataField::Z:
+        lua_pushnumber(L, pR->z);
+        break;
+    case RoomDataField::Env:
+        lua_pushnumber(L, pR->environment);
+        break;
+    case RoomDataField::Weight:
+        lua_pushnumber(L, pR->getWeight());
+        break;
+    case RoomDataField::Symbol:
+        lua_pushstring(L, pR->mSymbol.toUtf8().constData());
+        break;
+    case RoomDataField::Locked:
+        lua_pushboolean(L, pR->isLocked);
+        break;
+    case RoomDataField::Exits:
+        pushRoomExits(L, pR);
+        break;
+    case RoomDataField::UserData:
+        lua_newtable(L);
+        for (auto it = pR->userData.cbegin(), end = pR->userData.cend(); it != end; ++it) {
+            lua_pushstring(L, it.key().toUtf8().constData());
+            lua_pushstring(L, it.value().toUtf8().constData());
+            lua_settable(L, -3);
+        }
+        break;
+    case RoomDataField::UserDataItem:
+        if (!pR->userData.contains(request.userDataKey)) {
+            // Leave the item out rather than inventing a value for it:
+            return;
+        }
+        lua_pushstring(L, pR->userData.value(request.userDataKey).toUtf8().constData());
+        break;
+    }
+    lua_setfield(L, -2, request.name.constData());
+}
+
+// One validated change for setRoomsData(...) to make:
+struct RoomDataChange
+{
+    TRoom* pR;
+    RoomDataField field;
+    QString userDataKey;
+    QVariant value;
+};
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#getCustomLines
 int TLuaInterpreter::getCustomLines(lua_State* L)
 {
@@ -617,6 +728,19 @@ int TLuaInterpreter::auditAreas(lua_State* L)
     return 0;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#beginMapUpdate
+int TLuaInterpreter::beginMapUpdate(lua_State* L)
+{
+    const Host& host = getHostFromLua(L);
+    if (!host.mpMap || !host.mpMap->mpRoomDB) {
+        return warnArgumentValue(L, __func__, "no map present or loaded");
+    }
+
+    host.mpMap->beginBatchUpdate();
+    lua_pushboolean(L, true);
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#centerview
 int TLuaInterpreter::centerview(lua_State* L)
 {
@@ -763,8 +887,7 @@ int TLuaInterpreter::clearRoomUserData(lua_State* L)
     if (!pR) {
         return warnArgumentValue(L, __func__, csmInvalidRoomID.arg(roomId));
     }
-    if (!pR->userData.isEmpty()) {
-        pR->userData.clear();
+    if (pR->clearUserData()) {
         host.mpMap->setUnsaved(__func__);
         lua_pushboolean(L, true);
     } else {
@@ -794,8 +917,7 @@ int TLuaInterpreter::clearRoomUserDataItem(lua_State* L)
     //            // string we don't do anything, but we, successfully, fail to do it... 8-)
     //            lua_pushboolean( L, false );
     //        }
-    /*      else */ if (pR->userData.contains(key)) {
-        pR->userData.remove(key);
+    /*      else */ if (pR->removeUserData(key)) {
         host.mpMap->setUnsaved(__func__);
         lua_pushboolean(L, true);
     } else {
@@ -862,7 +984,7 @@ int TLuaInterpreter::connectExitStub(lua_State* L)
                 // a room with the given number and/or an exit stub:
                 const bool hasRoomWithNumberAsId = static_cast<bool>(host.mpMap->mpRoomDB->getRoom(value));
                 auto pR = host.mpMap->mpRoomDB->getRoom(fromRoom);
-                const bool hasExitStubWithNumberAsDirection = (pR && pR->exitStubs.contains(value));
+                const bool hasExitStubWithNumberAsDirection = (pR && pR->hasExitStub(value));
                 if (hasRoomWithNumberAsId) {
                     if (hasExitStubWithNumberAsDirection) {
                         return warnArgumentValue(
@@ -1185,6 +1307,22 @@ int TLuaInterpreter::enableMapInfo(lua_State* L)
     return 1;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#endMapUpdate
+int TLuaInterpreter::endMapUpdate(lua_State* L)
+{
+    const Host& host = getHostFromLua(L);
+    if (!host.mpMap || !host.mpMap->mpRoomDB) {
+        return warnArgumentValue(L, __func__, "no map present or loaded");
+    }
+
+    if (!host.mpMap->isInBatchUpdate()) {
+        return warnArgumentValue(L, __func__, "no map update is in progress, use beginMapUpdate() first");
+    }
+    host.mpMap->endBatchUpdate();
+    lua_pushboolean(L, true);
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#getAllAreaUserData
 int TLuaInterpreter::getAllAreaUserData(lua_State* L)
 {
@@ -1246,8 +1384,7 @@ int TLuaInterpreter::getAllRoomEntrances(lua_State* L)
         return warnArgumentValue(L, __func__, csmInvalidRoomID.arg(roomId));
     }
     lua_newtable(L);
-    QList<int> entrances = host.mpMap->mpRoomDB->getEntranceHash().values(roomId);
-    // Could use a .toSet().toList() to remove duplicates values
+    QList<int> entrances = host.mpMap->mpRoomDB->getEntrances(roomId);
     if (entrances.count() > 1) {
         std::sort(entrances.begin(), entrances.end());
     }
@@ -1948,67 +2085,7 @@ int TLuaInterpreter::getRoomExits(lua_State* L)
     const Host& host = getHostFromLua(L);
     TRoom* pR = host.mpMap->mpRoomDB->getRoom(id);
     if (pR) {
-        lua_newtable(L);
-        if (pR->getNorth() != -1) {
-            lua_pushstring(L, "north");
-            lua_pushnumber(L, pR->getNorth());
-            lua_settable(L, -3);
-        }
-        if (pR->getNorthwest() != -1) {
-            lua_pushstring(L, "northwest");
-            lua_pushnumber(L, pR->getNorthwest());
-            lua_settable(L, -3);
-        }
-        if (pR->getNortheast() != -1) {
-            lua_pushstring(L, "northeast");
-            lua_pushnumber(L, pR->getNortheast());
-            lua_settable(L, -3);
-        }
-        if (pR->getSouth() != -1) {
-            lua_pushstring(L, "south");
-            lua_pushnumber(L, pR->getSouth());
-            lua_settable(L, -3);
-        }
-        if (pR->getSouthwest() != -1) {
-            lua_pushstring(L, "southwest");
-            lua_pushnumber(L, pR->getSouthwest());
-            lua_settable(L, -3);
-        }
-        if (pR->getSoutheast() != -1) {
-            lua_pushstring(L, "southeast");
-            lua_pushnumber(L, pR->getSoutheast());
-            lua_settable(L, -3);
-        }
-        if (pR->getWest() != -1) {
-            lua_pushstring(L, "west");
-            lua_pushnumber(L, pR->getWest());
-            lua_settable(L, -3);
-        }
-        if (pR->getEast() != -1) {
-            lua_pushstring(L, "east");
-            lua_pushnumber(L, pR->getEast());
-            lua_settable(L, -3);
-        }
-        if (pR->getUp() != -1) {
-            lua_pushstring(L, "up");
-            lua_pushnumber(L, pR->getUp());
-            lua_settable(L, -3);
-        }
-        if (pR->getDown() != -1) {
-            lua_pushstring(L, "down");
-            lua_pushnumber(L, pR->getDown());
-            lua_settable(L, -3);
-        }
-        if (pR->getIn() != -1) {
-            lua_pushstring(L, "in");
-            lua_pushnumber(L, pR->getIn());
-            lua_settable(L, -3);
-        }
-        if (pR->getOut() != -1) {
-            lua_pushstring(L, "out");
-            lua_pushnumber(L, pR->getOut());
-            lua_settable(L, -3);
-        }
+        pushRoomExits(L, pR);
         return 1;
     } else {
         return 0;
@@ -2096,6 +2173,72 @@ int TLuaInterpreter::getRoomsByPosition(lua_State* L)
     return 1;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#getRoomsData
+int TLuaInterpreter::getRoomsData(lua_State* L)
+{
+    const Host& host = getHostFromLua(L);
+    if (!host.mpMap || !host.mpMap->mpRoomDB) {
+        return warnArgumentValue(L, __func__, "no map present or loaded");
+    }
+
+    if (!lua_istable(L, 1)) {
+        lua_pushfstring(L, "getRoomsData: bad argument #1 type (roomIDs as table expected, got %s!)", luaL_typename(L, 1));
+        return lua_error(L);
+    }
+
+    QList<RoomDataFieldRequest> requests;
+    if (lua_gettop(L) > 1 && !lua_isnil(L, 2)) {
+        if (!lua_istable(L, 2)) {
+            lua_pushfstring(L, "getRoomsData: bad argument #2 type (field names as table {optional} expected, got %s!)", luaL_typename(L, 2));
+            return lua_error(L);
+        }
+        lua_pushnil(L);
+        while (lua_next(L, 2) != 0) {
+            if (lua_type(L, -1) != LUA_TSTRING) {
+                lua_pushfstring(L, "getRoomsData: bad argument #2 type (field names as strings expected, got %s!)", luaL_typename(L, -1));
+                return lua_error(L);
+            }
+            const QByteArray fieldName{lua_tostring(L, -1)};
+            lua_pop(L, 1);
+            const QString field{QString::fromUtf8(fieldName)};
+            if (field.startsWith(QLatin1String("userData.")) && field.size() > 9) {
+                requests.append({RoomDataField::UserDataItem, fieldName, field.mid(9)});
+            } else if (scmRoomDataFields.contains(field)) {
+                requests.append({scmRoomDataFields.value(field), fieldName, QString()});
+            } else {
+                return warnArgumentValue(L, __func__, qsl("'%1' is not a room field that can be fetched").arg(field));
+            }
+        }
+    } else {
+        for (auto it = scmRoomDataFields.cbegin(), end = scmRoomDataFields.cend(); it != end; ++it) {
+            requests.append({it.value(), it.key().toUtf8(), QString()});
+        }
+    }
+
+    // Rooms that do not exist are left out of the result:
+    lua_newtable(L);
+    const int resultIndex = lua_gettop(L);
+    lua_pushnil(L);
+    while (lua_next(L, 1) != 0) {
+        if (lua_type(L, -1) != LUA_TNUMBER) {
+            lua_pushfstring(L, "getRoomsData: bad argument #1 type (roomIDs as numbers expected, got %s!)", luaL_typename(L, -1));
+            return lua_error(L);
+        }
+        const int roomId = static_cast<int>(lua_tointeger(L, -1));
+        lua_pop(L, 1);
+        const TRoom* pR = host.mpMap->mpRoomDB->getRoom(roomId);
+        if (!pR) {
+            continue;
+        }
+        lua_createtable(L, 0, requests.size());
+        for (const auto& request : qAsConst(requests)) {
+            pushRoomDataField(L, pR, request);
+        }
+        lua_rawseti(L, resultIndex, roomId);
+    }
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#getRoomUserData
 int TLuaInterpreter::getRoomUserData(lua_State* L)
 {
@@ -2991,23 +3134,8 @@ int TLuaInterpreter::searchRoom(lua_State* L)
             return 1;
         }
     } else {
-        QList<TRoom*> const roomList = host.mpMap->mpRoomDB->getRoomPtrList();
         lua_newtable(L);
-        QList<int> roomIdsFound;
-        for (auto pR : roomList) {
-            if (!pR) {
-                continue;
-            }
-            if (exactMatch) {
-                if (pR->name.compare(room, caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive) == 0) {
-                    roomIdsFound.append(pR->getId());
-                }
-            } else {
-                if (pR->name.contains(room, caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive)) {
-                    roomIdsFound.append(pR->getId());
-                }
-            }
-        }
+        QList<int> const roomIdsFound = host.mpMap->mpRoomDB->searchRoomsByName(room, caseSensitive, exactMatch);
         if (!roomIdsFound.isEmpty()) {
             for (const int i : roomIdsFound) {
                 TRoom* pR = host.mpMap->mpRoomDB->getRoom(i);
@@ -3046,25 +3174,11 @@ int TLuaInterpreter::searchRoomUserData(lua_State* L)
 
     lua_newtable(L);
 
-    QHashIterator<int, TRoom*> itRoom(host.mpMap->mpRoomDB->getRoomMap());
-    // For best performance do the three different types of action in three
-    // different branches each with a loop - rather than choosing a branch
-    // within a loop for each room
-
+    // These all use the indexes that TRoomDB maintains rather than looking
+    // at the user data of every room:
     lua_newtable(L);
     if (key.isNull()) { // Find all keys everywhere
-        QSet<QString> keysSet;
-        while (itRoom.hasNext()) {
-            itRoom.next();
-            // In the brave new world of range based initializers one must use
-            // a pair of iterators that point to the SAME thing that lasts
-            // long enough - using the output of a Qt method that returns a
-            // QList twice is not good enough and causes seg. faults...
-            QList<QString> roomDataKeysList{itRoom.value()->userData.keys()};
-            keysSet.unite(QSet<QString>{roomDataKeysList.begin(), roomDataKeysList.end()});
-        }
-
-        QStringList keys{keysSet.begin(), keysSet.end()};
+        QStringList keys = host.mpMap->mpRoomDB->getRoomUserDataKeys();
         if (keys.size() > 1) {
             std::sort(keys.begin(), keys.end());
         }
@@ -3075,18 +3189,7 @@ int TLuaInterpreter::searchRoomUserData(lua_State* L)
             lua_settable(L, -3);
         }
     } else if (value.isNull()) { // Find all values for a particular key in every room
-        QSet<QString> valuesSet; // Use a set as it automatically eliminates duplicates
-        while (itRoom.hasNext()) {
-            itRoom.next();
-            const QString roomValueForKey = itRoom.value()->userData.value(key, QString());
-            // If the key is NOT present, will return second argument which is a
-            // null QString which is NOT the same as an empty QString.
-            if (!roomValueForKey.isNull()) {
-                valuesSet.insert(roomValueForKey);
-            }
-        }
-
-        QStringList values{valuesSet.begin(), valuesSet.end()};
+        QStringList values = host.mpMap->mpRoomDB->getRoomUserDataValues(key);
         if (values.size() > 1) {
             std::sort(values.begin(), values.end());
         }
@@ -3097,17 +3200,7 @@ int TLuaInterpreter::searchRoomUserData(lua_State* L)
             lua_settable(L, -3);
         }
     } else { // Find all rooms where key and value match
-        QSet<int> roomIdsSet;
-        while (itRoom.hasNext()) {
-            itRoom.next();
-
-            const QString roomDataValue = itRoom.value()->userData.value(key, QString());
-            if ((!roomDataValue.isNull()) && (!value.compare(roomDataValue, Qt::CaseSensitive))) {
-                roomIdsSet.insert(itRoom.key());
-            }
-        }
-
-        QList<int> roomIds{roomIdsSet.begin(), roomIdsSet.end()};
+        QList<int> roomIds = host.mpMap->mpRoomDB->getRoomsWithUserData(key, value);
         if (roomIds.size() > 1) {
             std::sort(roomIds.begin(), roomIds.end());
         }
@@ -3283,18 +3376,18 @@ int TLuaInterpreter::setDoor(lua_State* L)
         // else IS a valid special exit - so fall out of if and continue
     } else {
         // Is a normal exit so see if it is valid
-        if (!(((!exitCmd.compare(qsl("n"))) && (pR->getExit(DIR_NORTH) > 0 || pR->exitStubs.contains(DIR_NORTH)))
-                || ((!exitCmd.compare(qsl("e"))) && (pR->getExit(DIR_EAST) > 0 || pR->exitStubs.contains(DIR_EAST)))
-                || ((!exitCmd.compare(qsl("s"))) && (pR->getExit(DIR_SOUTH) > 0 || pR->exitStubs.contains(DIR_SOUTH)))
-                || ((!exitCmd.compare(qsl("w"))) && (pR->getExit(DIR_WEST) > 0 || pR->exitStubs.contains(DIR_WEST)))
-                || ((!exitCmd.compare(qsl("ne"))) && (pR->getExit(DIR_NORTHEAST) > 0 || pR->exitStubs.contains(DIR_NORTHEAST)))
-                || ((!exitCmd.compare(qsl("se"))) && (pR->getExit(DIR_SOUTHEAST) > 0 || pR->exitStubs.contains(DIR_SOUTHEAST)))
-                || ((!exitCmd.compare(qsl("sw"))) && (pR->getExit(DIR_SOUTHWEST) > 0 || pR->exitStubs.contains(DIR_SOUTHWEST)))
-                || ((!exitCmd.compare(qsl("nw"))) && (pR->getExit(DIR_NORTHWEST) > 0 || pR->exitStubs.contains(DIR_NORTHWEST)))
-                || ((!exitCmd.compare(qsl("up"))) && (pR->getExit(DIR_UP) > 0 || pR->exitStubs.contains(DIR_UP)))
-                || ((!exitCmd.compare(qsl("down"))) && (pR->getExit(DIR_DOWN) > 0 || pR->exitStubs.contains(DIR_DOWN)))
-                || ((!exitCmd.compare(qsl("in"))) && (pR->getExit(DIR_IN) > 0 || pR->exitStubs.contains(DIR_IN)))
-                || ((!exitCmd.compare(qsl("out"))) && (pR->getExit(DIR_OUT) > 0 || pR->exitStubs.contains(DIR_OUT))))) {
+        if (!(((!exitCmd.compare(qsl("n"))) && (pR->getExit(DIR_NORTH) > 0 || pR->hasExitStub(DIR_NORTH)))
+                || ((!exitCmd.compare(qsl("e"))) && (pR->getExit(DIR_EAST) > 0 || pR->hasExitStub(DIR_EAST)))
+                || ((!exitCmd.compare(qsl("s"))) && (pR->getExit(DIR_SOUTH) > 0 || pR->hasExitStub(DIR_SOUTH)))
+                || ((!exitCmd.compare(qsl("w"))) && (pR->getExit(DIR_WEST) > 0 || pR->hasExitStub(DIR_WEST)))
+                || ((!exitCmd.compare(qsl("ne"))) && (pR->getExit(DIR_NORTHEAST) > 0 || pR->hasExitStub(DIR_NORTHEAST)))
+                || ((!exitCmd.compare(qsl("se"))) && (pR->getExit(DIR_SOUTHEAST) > 0 || pR->hasExitStub(DIR_SOUTHEAST)))
+                || ((!exitCmd.compare(qsl("sw"))) && (pR->getExit(DIR_SOUTHWEST) > 0 || pR->hasExitStub(DIR_SOUTHWEST)))
+                || ((!exitCmd.compare(qsl("nw"))) && (pR->getExit(DIR_NORTHWEST) > 0 || pR->hasExitStub(DIR_NORTHWEST)))
+                || ((!exitCmd.compare(qsl("up"))) && (pR->getExit(DIR_UP) > 0 || pR->hasExitStub(DIR_UP)))
+                || ((!exitCmd.compare(qsl("down"))) && (pR->getExit(DIR_DOWN) > 0 || pR->hasExitStub(DIR_DOWN)))
+                || ((!exitCmd.compare(qsl("in"))) && (pR->getExit(DIR_IN) > 0 || pR->hasExitStub(DIR_IN)))
+                || ((!exitCmd.compare(qsl("out"))) && (pR->getExit(DIR_OUT) > 0 || pR->hasExitStub(DIR_OUT))))) {
             // No there IS NOT a stub or real exit in the exitCmd direction
             return warnArgumentValue(L, __func__, qsl(
                 "roomID %1 does not have a normal exit or a stub exit in direction '%2'")
@@ -3639,13 +3732,171 @@ int TLuaInterpreter::setRoomName(lua_State* L)
     if (!pR) {
         return warnArgumentValue(L, __func__, csmInvalidRoomID.arg(id));
     }
-    pR->name = name;
+    pR->setName(name);
     host.mpMap->setUnsaved(__func__);
     host.mpMap->update();
     lua_pushboolean(L, true);
     return 1;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#setRoomsData
+int TLuaInterpreter::setRoomsData(lua_State* L)
+{
+    const Host& host = getHostFromLua(L);
+    if (!host.mpMap || !host.mpMap->mpRoomDB) {
+        return warnArgumentValue(L, __func__, "no map present or loaded");
+    }
+
+    if (!lua_istable(L, 1)) {
+        lua_pushfstring(L, "setRoomsData: bad argument #1 type (room data tables keyed by roomID as table expected, got %s!)", luaL_typename(L, 1));
+        return lua_error(L);
+    }
+
+    // Everything is checked before anything is changed so that a mistake
+    // anywhere in the table leaves the map untouched:
+    QList<RoomDataChange> changes;
+    lua_pushnil(L);
+    while (lua_next(L, 1) != 0) {
+        if (lua_type(L, -2) != LUA_TNUMBER || lua_type(L, -1) != LUA_TTABLE) {
+            lua_pushfstring(L, "setRoomsData: bad argument #1 type (room data tables keyed by roomID expected, got %s keyed by %s!)", luaL_typename(L, -1), luaL_typename(L, -2));
+            return lua_error(L);
+        }
+        const int roomId = static_cast<int>(lua_tointeger(L, -2));
+        TRoom* pR = host.mpMap->mpRoomDB->getRoom(roomId);
+        if (!pR) {
+            return warnArgumentValue(L, __func__, csmInvalidRoomID.arg(roomId));
+        }
+
+        lua_pushnil(L);
+        while (lua_next(L, -2) != 0) {
+            if (lua_type(L, -2) != LUA_TSTRING) {
+                lua_pushfstring(L, "setRoomsData: bad argument #1 type (room %d data keyed by field names as strings expected, got %s!)", roomId, luaL_typename(L, -2));
+                return lua_error(L);
+            }
+            const QString fieldName{QString::fromUtf8(lua_tostring(L, -2))};
+            // Exits need the checks that setExit(...) does so are not handled
+            // here:
+            if (!scmRoomDataFields.contains(fieldName) || scmRoomDataFields.value(fieldName) == RoomDataField::Exits) {
+                return warnArgumentValue(L, __func__, qsl("'%1' is not a room field that can be set").arg(fieldName));
+            }
+
+            const RoomDataField field = scmRoomDataFields.value(fieldName);
+            int expectedType = LUA_TNUMBER;
+            if (field == RoomDataField::Name || field == RoomDataField::Symbol) {
+                expectedType = LUA_TSTRING;
+            } else if (field == RoomDataField::Locked) {
+                expectedType = LUA_TBOOLEAN;
+            } else if (field == RoomDataField::UserData) {
+                expectedType = LUA_TTABLE;
+            }
+            if (lua_type(L, -1) != expectedType) {
+                lua_pushfstring(L, "setRoomsData: bad argument #1 type (room %d field '%s' as %s expected, got %s!)", roomId, lua_tostring(L, -2), lua_typename(L, expectedType), luaL_typename(L, -1));
+                return lua_error(L);
+            }
+
+            switch (field) {
+            case RoomDataField::Name:
+            case RoomDataField::Symbol:
+                changes.append({pR, field, QString(), QString::fromUtf8(lua_tostring(L, -1))});
+                break;
+            case RoomDataField::Locked:
+                changes.append({pR, field, QString(), static_cast<bool>(lua_toboolean(L, -1))});
+                break;
+            case RoomDataField::UserData:
+                lua_pushnil(L);
+                while (lua_next(L, -2) != 0) {
+                    if (lua_type(L, -2) != LUA_TSTRING || lua_type(L, -1) != LUA_TSTRING) {
+                        lua_pushfstring(L, "setRoomsData: bad argument #1 type (room %d field 'userData' as table of strings keyed by strings expected, got %s keyed by %s!)", roomId, luaL_typename(L, -1), luaL_typename(L, -2));
+                        return lua_error(L);
+                    }
+                    changes.append({pR, RoomDataField::UserDataItem, QString::fromUtf8(lua_tostring(L, -2)), QString::fromUtf8(lua_tostring(L, -1))});
+                    lua_pop(L, 1);
+                }
+                break;
+            default: {
+                const int value = static_cast<int>(lua_tointeger(L, -1));
+                if (field == RoomDataField::Area && (value < 1 || !host.mpMap->mpRoomDB->getAreaNamesMap().contains(value))) {
+                    return warnArgumentValue(L, __func__, csmInvalidAreaID.arg(value));
+                }
+                changes.append({pR, field, QString(), value});
+            }
+            }
+            lua_pop(L, 1);
+        }
+        lua_pop(L, 1);
+    }
+
+    // Area extents and exits are only worked out again, and the map only
+    // repainted, once all the changes have been made:
+    TMapBatchUpdate batchUpdate(host.mpMap);
+    bool isGraphChanged = false;
+    for (const auto& change : qAsConst(changes)) {
+        TRoom* pR = change.pR;
+        switch (change.field) {
+        case RoomDataField::Name:
+            pR->setName(change.value.toString());
+            break;
+        case RoomDataField::Area:
+            host.mpMap->setRoomArea(pR->getId(), change.value.toInt());
+            break;
+        case RoomDataField::X:
+            pR->x = change.value.toInt();
+            if (auto pA = host.mpMap->mpRoomDB->getArea(pR->getArea())) {
+                pA->calcSpan();
+            }
+            break;
+        case RoomDataField::Y:
+            pR->y = change.value.toInt();
+            if (auto pA = host.mpMap->mpRoomDB->getArea(pR->getArea())) {
+                pA->calcSpan();
+            }
+            break;
+        case RoomDataField::Z:
+            pR->z = change.value.toInt();
+            if (auto pA = host.mpMap->mpRoomDB->getArea(pR->getArea())) {
+                pA->calcSpan();
+            }
+            break;
+        case RoomDataField::Env:
+            pR->environment = change.value.toInt();
+            break;
+        case RoomDataField::Weight:
+            pR->setWeight(change.value.toInt());
+            isGraphChanged = true;
+            break;
+        case RoomDataField::Symbol:
+            if (change.value.toString().isEmpty()) {
+                pR->mSymbol.clear();
+            } else {
+                // As for setRoomChar(...):
+                pR->mSymbol = change.value.toString().normalized(QString::NormalizationForm_C, QChar::Unicode_10_0);
+            }
+            break;
+        case RoomDataField::Locked:
+            pR->isLocked = change.value.toBool();
+            isGraphChanged = true;
+            break;
+        case RoomDataField::UserDataItem:
+            pR->setUserData(change.userDataKey, change.value.toString());
+            break;
+        case RoomDataField::Exits:
+        case RoomDataField::UserData:
+            // Never recorded as changes:
+            break;
+        }
+    }
+
+    if (isGraphChanged) {
+        host.mpMap->mMapGraphNeedsUpdate = true;
+    }
+    if (!changes.isEmpty()) {
+        host.mpMap->setUnsaved(__func__);
+        host.mpMap->update();
+    }
+    lua_pushboolean(L, true);
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#setRoomUserData
 int TLuaInterpreter::setRoomUserData(lua_State* L)
 {
@@ -3663,7 +3914,7 @@ int TLuaInterpreter::setRoomUserData(lua_State* L)
     if (!pR) {
         return warnArgumentValue(L, __func__, csmInvalidRoomID.arg(roomId));
     }
-    pR->userData[key] = value;
+    pR->setUserData(key, value);
     host.mpMap->setUnsaved(__func__);
     host.mpMap->update();
     lua_pushboolean(L, true);
@@ -57,6 +57,7 @@
 #include "glwidget.h"
 #endif
 
+#include <algorithm>
 #include <limits>
 #include <math.h>
 
@@ -592,7 +593,7 @@ int TLuaInterpreter::getProfileStats(lua_State* L)
 {
     Host& host = getHostFromLua(L);
 
-    auto [_1, triggersTotal, totalPatterns, tempTriggers, activeTriggers, activePatterns] = host.getTriggerUnit()->assembleReport();
+    auto [_1, triggersTotal, totalPatterns, tempTriggers, activeTriggers, activePatterns, partialMatches] = host.getTriggerUnit()->assembleReport();
     auto [_2, aliasesTotal, tempAliases, activeAliases] = host.getAliasUnit()->assembleReport();
     auto [_3, timersTotal, tempTimers, activeTimers] = host.getTimerUnit()->assembleReport();
     auto [_4, keysTotal, tempKeys, activeKeys] = host.getKeyUnit()->assembleReport();
@@ -629,6 +630,10 @@ int TLuaInterpreter::getProfileStats(lua_State* L)
     lua_settable(L, -3);
 
     lua_settable(L, -3); // patterns
+
+    lua_pushstring(L, "partialMatches");
+    lua_pushnumber(L, partialMatches);
+    lua_settable(L, -3);
     lua_settable(L, -3); // triggers
 
     // Aliases
@@ -715,6 +720,41 @@ int TLuaInterpreter::getProfileStats(lua_State* L)
     return 1;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#getProfilerStats
+int TLuaInterpreter::getProfilerStats(lua_State* L)
+{
+    Host& host = getHostFromLua(L);
+    QList<TProfiler::Stats> stats = host.mProfiler.getStats();
+    std::sort(stats.begin(), stats.end(), [](const TProfiler::Stats& a, const TProfiler::Stats& b) { return a.mTotalTime > b.mTotalTime; });
+
+    // Times are given in milliseconds:
+    lua_createtable(L, stats.size(), 0);
+    int index = 0;
+    for (const auto& item : stats) {
+        lua_createtable(L, 0, 8);
+        lua_pushstring(L, TProfiler::typeName(item.mType).toUtf8().constData());
+        lua_setfield(L, -2, "type");
+        if (item.mId >= 0) {
+            lua_pushnumber(L, item.mId);
+            lua_setfield(L, -2, "id");
+        }
+        lua_pushstring(L, item.mName.toUtf8().constData());
+        lua_setfield(L, -2, "name");
+        lua_pushnumber(L, item.mCalls);
+        lua_setfield(L, -2, "calls");
+        lua_pushnumber(L, item.mTotalTime / 1.0e6);
+        lua_setfield(L, -2, "totalTime");
+        lua_pushnumber(L, item.mMaxTime / 1.0e6);
+        lua_setfield(L, -2, "maxTime");
+        lua_pushnumber(L, item.mMatchTime / 1.0e6);
+        lua_setfield(L, -2, "matchTime");
+        lua_pushnumber(L, item.mScriptTime / 1.0e6);
+        lua_setfield(L, -2, "scriptTime");
+        lua_rawseti(L, -2, ++index);
+    }
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#getStopWatches
 int TLuaInterpreter::getStopWatches(lua_State* L)
 {
@@ -989,7 +1029,7 @@ int TLuaInterpreter::isPrompt(lua_State* L)
 {
     const Host& host = getHostFromLua(L);
     const int userCursorY = host.mpConsole->getLineNumber();
-    if (userCursorY < host.mpConsole->buffer.promptBuffer.size() && userCursorY >= 0) {
+    if (userCursorY < static_cast<int>(host.mpConsole->buffer.promptBuffer.size()) && userCursorY >= 0) {
         lua_pushboolean(L, host.mpConsole->buffer.promptBuffer.at(userCursorY));
         return 1;
     } else {
@@ -1460,6 +1500,15 @@ int TLuaInterpreter::resetProfileIcon(lua_State* L)
     return 1;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#resetProfilerStats
+int TLuaInterpreter::resetProfilerStats(lua_State* L)
+{
+    Host& host = getHostFromLua(L);
+    host.mProfiler.reset();
+    lua_pushboolean(L, true);
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#resetStopWatch
 int TLuaInterpreter::resetStopWatch(lua_State* L)
 {
@@ -1559,6 +1608,16 @@ int TLuaInterpreter::setProfileIcon(lua_State* L)
     return 1;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#setProfilerEnabled
+int TLuaInterpreter::setProfilerEnabled(lua_State* L)
+{
+    const bool state = getVerifiedBool(L, __func__, 1, "enabled");
+    Host& host = getHostFromLua(L);
+    host.mProfiler.setEnabled(state);
+    lua_pushboolean(L, true);
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#setScript
 int TLuaInterpreter::setScript(lua_State* L)
 {
@@ -39,6 +39,7 @@
 #include "TEvent.h"
 #include "TFlipButton.h"
 #include "TForkedProcess.h"
+#include "THighlighter.h"
 #include "TLabel.h"
 #include "TMapLabel.h"
 #include "TMedia.h"
@@ -229,6 +230,37 @@ int TLuaInterpreter::appendBuffer(lua_State* L)
     return 0;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#applyHighlighter
+int TLuaInterpreter::applyHighlighter(lua_State* L)
+{
+    int s = 1;
+    QString windowName;
+    if (lua_type(L, s) == LUA_TSTRING) {
+        windowName = WINDOW_NAME(L, s++);
+    }
+
+    const int id = getVerifiedInt(L, __func__, s++, "highlighter ID");
+    const Host& host = getHostFromLua(L);
+    auto pHighlighter = host.getHighlighter(id);
+    if (!pHighlighter) {
+        return warnArgumentValue(L, __func__, qsl("highlighter ID %1 does not exist").arg(id));
+    }
+
+    auto console = CONSOLE(L, windowName);
+    int lineNumber = console->getLineNumber();
+    if (lua_gettop(L) >= s) {
+        lineNumber = getVerifiedInt(L, __func__, s, "line number {default = current line}", true);
+    }
+
+    const int runCount = console->applyHighlighter(*pHighlighter, lineNumber);
+    if (runCount < 0) {
+        return warnArgumentValue(L, __func__, qsl("line number %1 does not exist").arg(lineNumber));
+    }
+
+    lua_pushnumber(L, runCount);
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#calcFontSize
 int TLuaInterpreter::calcFontSize(lua_State* L)
 {
@@ -356,6 +388,143 @@ int TLuaInterpreter::createCommandLine(lua_State* L)
     return 1;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#createHighlighter
+int TLuaInterpreter::createHighlighter(lua_State* L)
+{
+    if (!lua_istable(L, 1)) {
+        lua_pushfstring(L, "createHighlighter: bad argument #1 type (highlight rules as table expected, got %s!)", luaL_typename(L, 1));
+        return lua_error(L);
+    }
+
+    // These helpers all work on the rule table at the top of the stack.
+    // A field that may hold a single string or an array of them:
+    auto readStrings = [L](const char* fieldName, QStringList& strings) -> bool {
+        lua_getfield(L, -1, fieldName);
+        bool isOk = true;
+        if (lua_type(L, -1) == LUA_TSTRING) {
+            strings.append(QString::fromUtf8(lua_tostring(L, -1)));
+        } else if (lua_istable(L, -1)) {
+            for (int i = 1;; ++i) {
+                lua_rawgeti(L, -1, i);
+                if (lua_isnil(L, -1)) {
+                    lua_pop(L, 1);
+                    break;
+                }
+                if (lua_type(L, -1) != LUA_TSTRING) {
+                    isOk = false;
+                    lua_pop(L, 1);
+                    break;
+                }
+                strings.append(QString::fromUtf8(lua_tostring(L, -1)));
+                lua_pop(L, 1);
+            }
+        } else if (!lua_isnil(L, -1)) {
+            isOk = false;
+        }
+        lua_pop(L, 1);
+        return isOk;
+    };
+
+    // An optional { r, g, b [, alpha] } table:
+    auto readColor = [L](const char* fieldName, QColor& color) -> bool {
+        lua_getfield(L, -1, fieldName);
+        bool isOk = true;
+        if (lua_istable(L, -1)) {
+            int components[4] = {0, 0, 0, 255};
+            for (int i = 1; i <= 4; ++i) {
+                lua_rawgeti(L, -1, i);
+                if (lua_isnumber(L, -1)) {
+                    components[i - 1] = static_cast<int>(lua_tointeger(L, -1));
+                    if (components[i - 1] < 0 || components[i - 1] > 255) {
+                        isOk = false;
+                    }
+                } else if (i < 4 || !lua_isnil(L, -1)) {
+                    isOk = false;
+                }
+                lua_pop(L, 1);
+            }
+            if (isOk) {
+                color = QColor(components[0], components[1], components[2], components[3]);
+            }
+        } else if (!lua_isnil(L, -1)) {
+            isOk = false;
+        }
+        lua_pop(L, 1);
+        return isOk;
+    };
+
+    auto readBoolean = [L](const char* fieldName) -> bool {
+        lua_getfield(L, -1, fieldName);
+        const bool result = lua_toboolean(L, -1);
+        lua_pop(L, 1);
+        return result;
+    };
+
+    static const std::pair<const char*, TChar::AttributeFlag> attributeFields[] = {
+            {"bold", TChar::Bold},
+            {"italic", TChar::Italic},
+            {"underline", TChar::Underline},
+            {"overline", TChar::Overline},
+            {"strikeout", TChar::StrikeOut},
+            {"reverse", TChar::Reverse}};
+
+    auto pHighlighter = QSharedPointer<THighlighter>::create();
+    int ruleIndex = 1;
+    for (;; ++ruleIndex) {
+        lua_rawgeti(L, 1, ruleIndex);
+        if (lua_isnil(L, -1)) {
+            lua_pop(L, 1);
+            break;
+        }
+        if (!lua_istable(L, -1)) {
+            lua_pushfstring(L, "createHighlighter: bad argument #1 type (rule #%d as table expected, got %s!)", ruleIndex, luaL_typename(L, -1));
+            return lua_error(L);
+        }
+
+        THighlighter::Format format;
+        if (!readColor("fg", format.mFgColor) || !readColor("bg", format.mBgColor)) {
+            return warnArgumentValue(L, __func__, qsl("rule #%1 has a color that is not a table of 3 (or 4) numbers between 0 and 255").arg(ruleIndex));
+        }
+        for (const auto& [fieldName, flag] : attributeFields) {
+            if (readBoolean(fieldName)) {
+                format.mAttributes |= flag;
+            }
+        }
+        const bool wholeWord = readBoolean("wholeWord");
+
+        QStringList texts;
+        QStringList patterns;
+        if (!readStrings("text", texts) || !readStrings("pattern", patterns)) {
+            return warnArgumentValue(L, __func__, qsl("rule #%1 has a text or pattern that is not a string or a table of strings").arg(ruleIndex));
+        }
+        texts.removeAll(QString());
+        if (texts.isEmpty() && patterns.isEmpty()) {
+            return warnArgumentValue(L, __func__, qsl("rule #%1 has no text or pattern to look for").arg(ruleIndex));
+        }
+
+        const int formatIndex = pHighlighter->addFormat(format);
+        for (const auto& text : qAsConst(texts)) {
+            pHighlighter->addString(text, formatIndex, wholeWord);
+        }
+        for (const auto& pattern : qAsConst(patterns)) {
+            QString errorMessage;
+            if (!pHighlighter->addPattern(pattern, formatIndex, wholeWord, errorMessage)) {
+                return warnArgumentValue(L, __func__, qsl("rule #%1 pattern \"%2\" is not valid, reason: %3").arg(QString::number(ruleIndex), pattern, errorMessage));
+            }
+        }
+        lua_pop(L, 1);
+    }
+
+    if (ruleIndex == 1) {
+        return warnArgumentValue(L, __func__, "no highlight rules given");
+    }
+
+    pHighlighter->compile();
+    Host& host = getHostFromLua(L);
+    lua_pushnumber(L, host.addHighlighter(pHighlighter));
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#createLabel
 int TLuaInterpreter::createLabel(lua_State* L)
 {
@@ -457,6 +626,19 @@ int TLuaInterpreter::createScrollBox(lua_State* L)
     return 1;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#deleteHighlighter
+int TLuaInterpreter::deleteHighlighter(lua_State* L)
+{
+    const int id = getVerifiedInt(L, __func__, 1, "highlighter ID");
+    Host& host = getHostFromLua(L);
+    if (!host.removeHighlighter(id)) {
+        return warnArgumentValue(L, __func__, qsl("highlighter ID %1 does not exist").arg(id));
+    }
+
+    lua_pushboolean(L, true);
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#deleteLabel
 int TLuaInterpreter::deleteLabel(lua_State* L)
 {
@@ -544,6 +726,16 @@ int TLuaInterpreter::disableScrollBar(lua_State* L)
     return 0;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#disableScrollbackArchive
+int TLuaInterpreter::disableScrollbackArchive(lua_State* L)
+{
+    const QString windowName {WINDOW_NAME(L, 1)};
+    auto console = CONSOLE(L, windowName);
+    console->setScrollbackArchiveEnabled(false);
+    lua_pushboolean(L, true);
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#echoLink
 int TLuaInterpreter::echoLink(lua_State* L)
 {
@@ -718,6 +910,52 @@ int TLuaInterpreter::enableScrollBar(lua_State* L)
     return 0;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#enableScrollbackArchive
+int TLuaInterpreter::enableScrollbackArchive(lua_State* L)
+{
+    const QString windowName {WINDOW_NAME(L, 1)};
+    auto console = CONSOLE(L, windowName);
+    if (!console->setScrollbackArchiveEnabled(true)) {
+        return warnArgumentValue(L, __func__, qsl("unable to create a scrollback archive file for '%1'").arg(console->mConsoleName));
+    }
+    lua_pushboolean(L, true);
+    return 1;
+}
+
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#getArchivedLineCount
+int TLuaInterpreter::getArchivedLineCount(lua_State* L)
+{
+    const QString windowName {WINDOW_NAME(L, 1)};
+    auto console = CONSOLE(L, windowName);
+    lua_pushnumber(L, console->getArchivedLineCount());
+    return 1;
+}
+
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#getArchivedLines
+int TLuaInterpreter::getArchivedLines(lua_State* L)
+{
+    const int n = lua_gettop(L);
+    int s = 1;
+    QString windowName;
+    if (n > 2) {
+        windowName = WINDOW_NAME(L, s++);
+    }
+    const int lineFrom = getVerifiedInt(L, __func__, s++, "start line");
+    const int lineTo = getVerifiedInt(L, __func__, s, "end line");
+
+    auto console = CONSOLE(L, windowName);
+    if (!console->isScrollbackArchiveEnabled()) {
+        return warnArgumentValue(L, __func__, qsl("the scrollback archive is not enabled for '%1'").arg(console->mConsoleName));
+    }
+    const QStringList lines = console->getArchivedLines(lineFrom, lineTo);
+    lua_createtable(L, lines.size(), 0);
+    for (int i = 0, total = lines.size(); i < total; ++i) {
+        lua_pushstring(L, lines.at(i).toUtf8().constData());
+        lua_rawseti(L, -2, i + 1);
+    }
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#getAvailableFonts
 int TLuaInterpreter::getAvailableFonts(lua_State* L)
 {
@@ -2454,6 +2692,24 @@ int TLuaInterpreter::setFontSize(lua_State* L)
     return 1;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#setGaugeValue
+int TLuaInterpreter::setGaugeValue(lua_State* L)
+{
+    const QString gaugeName = getVerifiedString(L, __func__, 1, "gauge name");
+    const double percent = getVerifiedDouble(L, __func__, 2, "percentage");
+    QString orientation = qsl("horizontal");
+    if (lua_gettop(L) > 2) {
+        orientation = getVerifiedString(L, __func__, 3, "orientation", true);
+    }
+
+    Host& host = getHostFromLua(L);
+    if (auto [success, message] = host.setGaugeValue(gaugeName, percent, orientation); !success) {
+        return warnArgumentValue(L, __func__, message);
+    }
+    lua_pushboolean(L, true);
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#setItalics
 int TLuaInterpreter::setItalics(lua_State* L)
 {
@@ -2926,6 +3182,19 @@ int TLuaInterpreter::setWindow(lua_State* L)
     return 1;
 }
 
+// Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#setWindowGeometry
+int TLuaInterpreter::setWindowGeometry(lua_State* L)
+{
+    const QString name = getVerifiedString(L, __func__, 1, "name");
+    const double x = getVerifiedDouble(L, __func__, 2, "x");
+    const double y = getVerifiedDouble(L, __func__, 3, "y");
+    const double width = getVerifiedDouble(L, __func__, 4, "width");
+    const double height = getVerifiedDouble(L, __func__, 5, "height");
+    Host& host = getHostFromLua(L);
+    lua_pushboolean(L, host.setWindowGeometry(name, static_cast<int>(x), static_cast<int>(y), static_cast<int>(width), static_cast<int>(height)));
+    return 1;
+}
+
 // Documentation: https://wiki.mudlet.org/w/Manual:Lua_Functions#setWindowWrap
 int TLuaInterpreter::setWindowWrap(lua_State* L)
 {
@@ -3129,12 +3398,13 @@ int TLuaInterpreter::scrollTo(lua_State* L)
 
     if (stopScrolling) {
         if (!console->mUpperPane->mIsTailMode) {
+            console->mUpperPane->mIsTailMode = true;
+            console->buffer.trimToLinesLimit();
             console->mLowerPane->mCursorY = console->buffer.size();
             console->mLowerPane->hide();
             console->buffer.mCursorY = console->buffer.size();
             console->mUpperPane->mCursorY = console->buffer.size();
             console->mUpperPane->mCursorX = 0;
-            console->mUpperPane->mIsTailMode = true;
             console->mUpperPane->updateScreenView();
             console->mUpperPane->forceUpdate();
         }
@@ -1166,7 +1166,18 @@ void TMainConsole::printOnDisplay(std::string& incomingSocketData, const bool is
     }
 
     const double processT = mProcessingTimer.elapsed() / 1000.0;
-    if (mpHost->mTelnet.mGA_Driver) {
+    const qint64 backlog = mpHost->mTelnet.getReceiveBacklog();
+    if (backlog > 0) {
+        /*:
+        Shown instead of the usual latency display whilst received data is
+        still queued up waiting to be processed; the first argument 'S' represents
+        the 'S'ystem (processing) time, the second 'Q' the amount of data
+        'Q'ueued in KiB
+        */
+        mpLineEdit_networkLatency->setText(tr("S:%1 Q:%2k")
+                                                   .arg(processT, 0, 'f', 3)
+                                                   .arg((backlog + 1023) / 1024));
+    } else if (mpHost->mTelnet.mGA_Driver) {
         /*:
         The first argument 'N' represents the 'N'etwork latency; the second 'S' the
         'S'ystem (processing) time
@@ -26,6 +26,7 @@
 #include "TArea.h"
 #include "TConsole.h"
 #include "TEvent.h"
+#include "TJsonArraySplicer.h"
 #include "TMapLabel.h"
 #include "TRoomDB.h"
 #include "XMLimport.h"
@@ -41,6 +42,8 @@
 #include <QProgressDialog>
 #include <QPainter>
 #include <QBuffer>
+#include <QThread>
+#include <QtConcurrent>
 #include "post_guard.h"
 
 
@@ -184,6 +187,13 @@ bool TMap::setRoomCoordinates(int id, int x, int y, int z)
     pR->y = y;
     pR->z = z;
 
+    if (mBatchUpdateDepth) {
+        // Make sure the area extents are right once the batch ends:
+        if (auto pA = mpRoomDB->getArea(pR->getArea())) {
+            deferAreaRecalculation(pA);
+        }
+    }
+
     setUnsaved(__func__);
     return true;
 }
@@ -213,7 +223,7 @@ QString TMap::connectExitStubByDirection(const int fromRoomId, const int dirType
     int minDistanceRoom = 0;
     int meanSquareDistance = 0;
 
-    if (!pFromR->exitStubs.contains(dirType)) {
+    if (!pFromR->hasExitStub(dirType)) {
         return qsl("fromID (%1) does not have an exit stub in the given direction '%2' (%3)")
                 .arg(QString::number(fromRoomId), TRoom::dirCodeToString(dirType), QString::number(dirType));
     }
@@ -246,7 +256,7 @@ QString TMap::connectExitStubByDirection(const int fromRoomId, const int dirType
 
         // New test - does this room have a stub exit in the wanted reverse
         // direction:
-        if (!pToR->exitStubs.contains(reverseDir)) {
+        if (!pToR->hasExitStub(reverseDir)) {
             continue;
         }
 
@@ -408,7 +418,7 @@ QString TMap::connectExitStubByDirectionAndToId(const int fromRoomId, const int
         return qsl("fromID and toID are the same (%1)").arg(fromRoomId);
     }
 
-    if (!pFromR->exitStubs.contains(dirType)) {
+    if (!pFromR->hasExitStub(dirType)) {
         return qsl("fromID (%1) does not have an exit stub in the given direction '%2' (%3)")
                 .arg(QString::number(fromRoomId), TRoom::dirCodeToString(dirType), QString::number(dirType));
     }
@@ -418,7 +428,7 @@ QString TMap::connectExitStubByDirectionAndToId(const int fromRoomId, const int
         return qsl("toID (%1) room does not exist").arg(toRoomId);
     }
 
-    if (!pToR->exitStubs.contains(scmReverseDirections.value(dirType))) {
+    if (!pToR->hasExitStub(scmReverseDirections.value(dirType))) {
         return qsl("toID (%1) does not have an exit stub in the reverse direction '%2' (%3) of that given '%4' (%5)")
                 .arg(QString::number(toRoomId),
                      TRoom::dirCodeToString(scmReverseDirections.value(dirType)),
@@ -714,7 +724,8 @@ void TMap::initGraph()
         QHash<unsigned int, route> bestRoutes;
         // key is target (destination room),
         // value is data we will need to store later,
-        QMap<QString, int> const exitWeights = pSourceR->getExitWeights();
+        // Only needed for the special exits now:
+        const QMap<QString, int>& exitWeights = pSourceR->getExitWeights();
 
         int target = pSourceR->getNorth();
         TRoom* pTargetR;
@@ -727,7 +738,7 @@ void TMap::initGraph()
             pTargetR = mpRoomDB->getRoom(target);
             if (pTargetR && !pTargetR->isLocked) { // OK got something that is valid
                 route r;
-                r.cost = exitWeights.value(qsl("n"), pTargetR->getWeight());
+                r.cost = pSourceR->getExitWeight(direction, pTargetR->getWeight());
                 r.direction = direction;
                 bestRoutes.insert(target, r);
             }
@@ -739,7 +750,7 @@ void TMap::initGraph()
             pTargetR = mpRoomDB->getRoom(target);
             if (pTargetR && !pTargetR->isLocked) {
                 route r;
-                r.cost = exitWeights.value(qsl("e"), pTargetR->getWeight());
+                r.cost = pSourceR->getExitWeight(direction, pTargetR->getWeight());
                 if (!bestRoutes.contains(target) || bestRoutes.value(target).cost > r.cost) { // Ah, this is a better route
                     r.direction = direction;
                     bestRoutes.insert(target, r); // If the second part of conditional is the truth this will replace previous best route to this target
@@ -753,7 +764,7 @@ void TMap::initGraph()
             pTargetR = mpRoomDB->getRoom(target);
             if (pTargetR && !pTargetR->isLocked) {
                 route r;
-                r.cost = exitWeights.value(qsl("s"), pTargetR->getWeight());
+                r.cost = pSourceR->getExitWeight(direction, pTargetR->getWeight());
                 if (!bestRoutes.contains(target) || bestRoutes.value(target).cost > r.cost) {
                     r.direction = direction;
                     bestRoutes.insert(target, r);
@@ -767,7 +778,7 @@ void TMap::initGraph()
             pTargetR = mpRoomDB->getRoom(target);
             if (pTargetR && !pTargetR->isLocked) {
                 route r;
-                r.cost = exitWeights.value(qsl("w"), pTargetR->getWeight());
+                r.cost = pSourceR->getExitWeight(direction, pTargetR->getWeight());
                 if (!bestRoutes.contains(target) || bestRoutes.value(target).cost > r.cost) {
                     r.direction = direction;
                     bestRoutes.insert(target, r);
@@ -781,7 +792,7 @@ void TMap::initGraph()
             pTargetR = mpRoomDB->getRoom(target);
             if (pTargetR && !pTargetR->isLocked) {
                 route r;
-                r.cost = exitWeights.value(qsl("up"), pTargetR->getWeight());
+                r.cost = pSourceR->getExitWeight(direction, pTargetR->getWeight());
                 if (!bestRoutes.contains(target) || bestRoutes.value(target).cost > r.cost) {
                     r.direction = direction;
                     bestRoutes.insert(target, r);
@@ -795,7 +806,7 @@ void TMap::initGraph()
             pTargetR = mpRoomDB->getRoom(target);
             if (pTargetR && !pTargetR->isLocked) {
                 route r;
-                r.cost = exitWeights.value(qsl("down"), pTargetR->getWeight());
+                r.cost = pSourceR->getExitWeight(direction, pTargetR->getWeight());
                 if (!bestRoutes.contains(target) || bestRoutes.value(target).cost > r.cost) {
                     r.direction = direction;
                     bestRoutes.insert(target, r);
@@ -809,7 +820,7 @@ void TMap::initGraph()
             pTargetR = mpRoomDB->getRoom(target);
             if (pTargetR && !pTargetR->isLocked) {
                 route r;
-                r.cost = exitWeights.value(qsl("ne"), pTargetR->getWeight());
+                r.cost = pSourceR->getExitWeight(direction, pTargetR->getWeight());
                 if (!bestRoutes.contains(target) || bestRoutes.value(target).cost > r.cost) {
                     r.direction = direction;
                     bestRoutes.insert(target, r);
@@ -823,7 +834,7 @@ void TMap::initGraph()
             pTargetR = mpRoomDB->getRoom(target);
             if (pTargetR && !pTargetR->isLocked) {
                 route r;
-                r.cost = exitWeights.value(qsl("se"), pTargetR->getWeight());
+                r.cost = pSourceR->getExitWeight(direction, pTargetR->getWeight());
                 if (!bestRoutes.contains(target) || bestRoutes.value(target).cost > r.cost) {
                     r.direction = direction;
                     bestRoutes.insert(target, r);
@@ -837,7 +848,7 @@ void TMap::initGraph()
             pTargetR = mpRoomDB->getRoom(target);
             if (pTargetR && !pTargetR->isLocked) {
                 route r;
-                r.cost = exitWeights.value(qsl("sw"), pTargetR->getWeight());
+                r.cost = pSourceR->getExitWeight(direction, pTargetR->getWeight());
                 if (!bestRoutes.contains(target) || bestRoutes.value(target).cost > r.cost) {
                     r.direction = direction;
                     bestRoutes.insert(target, r);
@@ -851,7 +862,7 @@ void TMap::initGraph()
             pTargetR = mpRoomDB->getRoom(target);
             if (pTargetR && !pTargetR->isLocked) {
                 route r;
-                r.cost = exitWeights.value(qsl("nw"), pTargetR->getWeight());
+                r.cost = pSourceR->getExitWeight(direction, pTargetR->getWeight());
                 if (!bestRoutes.contains(target) || bestRoutes.value(target).cost > r.cost) {
                     r.direction = direction;
                     bestRoutes.insert(target, r);
@@ -865,7 +876,7 @@ void TMap::initGraph()
             pTargetR = mpRoomDB->getRoom(target);
             if (pTargetR && !pTargetR->isLocked) {
                 route r;
-                r.cost = exitWeights.value(qsl("in"), pTargetR->getWeight());
+                r.cost = pSourceR->getExitWeight(direction, pTargetR->getWeight());
                 if (!bestRoutes.contains(target) || bestRoutes.value(target).cost > r.cost) {
                     r.direction = direction;
                     bestRoutes.insert(target, r);
@@ -879,7 +890,7 @@ void TMap::initGraph()
             pTargetR = mpRoomDB->getRoom(target);
             if (pTargetR && !pTargetR->isLocked) {
                 route r;
-                r.cost = exitWeights.value(qsl("out"), pTargetR->getWeight());
+                r.cost = pSourceR->getExitWeight(direction, pTargetR->getWeight());
                 if (!bestRoutes.contains(target) || bestRoutes.value(target).cost > r.cost) {
                     r.direction = direction;
                     bestRoutes.insert(target, r);
@@ -1153,7 +1164,14 @@ bool TMap::serialize(QDataStream& ofs, int saveVersion)
     ofs << mEnvColors;
     ofs << mpRoomDB->getAreaNamesMap();
     ofs << mCustomEnvColors;
-    ofs << mpRoomDB->hashToRoomID;
+    {
+        // This has always been saved as a QMap:
+        QMap<QString, int> hashToRoomID;
+        for (auto i = mpRoomDB->hashToRoomID.constBegin(); i != mpRoomDB->hashToRoomID.constEnd(); ++i) {
+            hashToRoomID.insert(i.key(), i.value());
+        }
+        ofs << hashToRoomID;
+    }
     if (mSaveVersion < 19) {
         // Save the data in the map user data for older versions
         mUserData.insert(qsl("system.fallback_mapSymbolFont"), mMapSymbolFont.toString());
@@ -1300,7 +1318,7 @@ bool TMap::serialize(QDataStream& ofs, int saveVersion)
         ofs << pR->getId();
         if (mSaveVersion <= 19) {
             if (!pR->mSymbol.isEmpty()) {
-                pR->userData.insert(QLatin1String("system.fallback_symbol"), pR->mSymbol);
+                pR->setUserData(QLatin1String("system.fallback_symbol"), pR->mSymbol);
             }
         }
         ofs << pR->getArea();
@@ -1362,7 +1380,7 @@ bool TMap::serialize(QDataStream& ofs, int saveVersion)
             ofs << pR->mSymbolColor;
         } else {
             if (pR->mSymbolColor.isValid()) {
-                pR->userData.insert(QLatin1String("system.fallback_symbol_color"), pR->mSymbolColor.name());
+                pR->setUserData(QLatin1String("system.fallback_symbol_color"), pR->mSymbolColor.name());
             }
         }
 
@@ -1660,9 +1678,12 @@ bool TMap::restore(QString location, bool downloadIfNotFound)
             ifs >> mCustomEnvColors;
         }
         if (mVersion >= 7) {
-            ifs >> mpRoomDB->hashToRoomID;
-            QMap<QString, int>::const_iterator i;
-            for (i = mpRoomDB->hashToRoomID.constBegin(); i != mpRoomDB->hashToRoomID.constEnd(); ++i) {
+            QMap<QString, int> hashToRoomID;
+            ifs >> hashToRoomID;
+            mpRoomDB->hashToRoomID.reserve(hashToRoomID.size());
+            mpRoomDB->roomIDToHash.reserve(hashToRoomID.size());
+            for (auto i = hashToRoomID.constBegin(); i != hashToRoomID.constEnd(); ++i) {
+                mpRoomDB->hashToRoomID.insert(i.key(), i.value());
                 mpRoomDB->roomIDToHash.insert(i.value(), i.key());
             }
         }
@@ -2936,38 +2957,31 @@ std::pair<bool, QString> TMap::writeJsonMapFile(const QString& dest)
         std::sort(areaIdsList.begin(), areaIdsList.end());
     }
 
-    mProgressDialogAreasCount = 0;
-    mProgressDialogRoomsCount = 0;
-    mProgressDialogLabelsCount = 0;
-    bool abort = false;
-    QJsonArray areasArray;
+    // The areas are not gathered into this object, instead a unique
+    // placeholder marks where they go and each area is written out in its
+    // place as soon as it has been turned into text:
+    TJsonArraySplicer areasSplicer(file, QLatin1String("areas"));
+    areasSplicer.insertPlaceholder(mapObj);
+
+    // This used to be tallied while the areas were written but it is needed
+    // up front now:
+    int roomCount = 0;
     for (const auto area : mpRoomDB->getAreaMap()) {
         if (area) {
-            area->writeJsonArea(areasArray);
-        }
-        ++mProgressDialogAreasCount;
-        if (incrementJsonProgressDialog(true, true, 0)) {
-            abort = true;
-            break;
+            for (const auto roomId : area->getAreaRooms()) {
+                if (mpRoomDB->getRoom(roomId)) {
+                    ++roomCount;
+                }
+            }
         }
     }
-    if (abort) {
-        file.cancelWriting();
-        mpProgressDialog->setAttribute(Qt::WA_DeleteOnClose, true);
-        mpProgressDialog->close();
-        mpProgressDialog = nullptr;
-        return {false, qsl("aborted by user")};
-    }
-
-    const QJsonValue areasValue{areasArray};
-    mapObj.insert(QLatin1String("areas"), areasValue);
 
     // Should Qt change things so that the order in the file is not
     // alphabetically sorted but instead dependent on actually insertion order
     // then these must be precalculated and put first - as they are needed to
     // drive the progress dialogue:
     mapObj.insert(QLatin1String("areaCount"), static_cast<double>(areaIdsList.count()));
-    mapObj.insert(QLatin1String("roomCount"), static_cast<double>(mProgressDialogRoomsCount));
+    mapObj.insert(QLatin1String("roomCount"), static_cast<double>(roomCount));
     mapObj.insert(QLatin1String("labelCount"), static_cast<double>(mProgressDialogLabelsTotal));
 
     const QJsonValue defaultAreaNameValue{mDefaultAreaName};
@@ -3034,12 +3048,56 @@ std::pair<bool, QString> TMap::writeJsonMapFile(const QString& dest)
     mapObj.insert(QLatin1String("playerRoomOuterDiameterPercentage"), static_cast<double>(mPlayerRoomOuterDiameterPercentage));
     mapObj.insert(QLatin1String("playerRoomInnerDiameterPercentage"), static_cast<double>(mPlayerRoomInnerDiameterPercentage));
 
+    const bool areasPlaceholderFound = areasSplicer.begin(mapObj);
+    Q_ASSERT_X(areasPlaceholderFound, "TMap::writeJsonMapFile(...)", "areas placeholder missing from JSON text");
+    Q_UNUSED(areasPlaceholderFound)
+
+    // Each area is converted to text on a worker thread whilst the next one is
+    // being gathered here - QPixmap and the progress dialog must only be used
+    // from the main thread. The finished text is written out in area order
+    // and only a few areas are ever held in memory at once:
+    const int maxPendingAreas = std::max(2, QThread::idealThreadCount() * 2);
+    QList<QFuture<QByteArray>> pendingAreas;
+
+    mProgressDialogAreasCount = 0;
+    mProgressDialogRoomsCount = 0;
+    mProgressDialogLabelsCount = 0;
+    bool abort = false;
+    for (const auto area : mpRoomDB->getAreaMap()) {
+        if (area) {
+            const QJsonObject areaObj{area->writeJsonArea()};
+            if (!mpProgressDialog->wasCanceled()) {
+                pendingAreas.append(QtConcurrent::run(TJsonArraySplicer::elementText, areaObj));
+            }
+        }
+        ++mProgressDialogAreasCount;
+        if (incrementJsonProgressDialog(true, true, 0)) {
+            abort = true;
+            break;
+        }
+        while (!pendingAreas.isEmpty() && (pendingAreas.first().isFinished() || pendingAreas.count() > maxPendingAreas)) {
+            areasSplicer.appendElement(pendingAreas.takeFirst().result());
+        }
+    }
+    if (abort) {
+        // Any areas still being converted only hold their own copies of the
+        // data so they can be left to finish on their own:
+        file.cancelWriting();
+        mpProgressDialog->setAttribute(Qt::WA_DeleteOnClose, true);
+        mpProgressDialog->close();
+        mpProgressDialog = nullptr;
+        return {false, qsl("aborted by user")};
+    }
+
     mpProgressDialog->setLabelText(tr("Exporting JSON map file from %1 - writing data to file:\n"
                                       "%2 ...").arg(mProfileName, destination));
     mpProgressDialog->setValue(0);
     // Hide the cancel button as we can't stop now:
     mpProgressDialog->setCancelButton(nullptr);
-    file.write(QJsonDocument(mapObj).toJson(QJsonDocument::Indented));
+    while (!pendingAreas.isEmpty()) {
+        areasSplicer.appendElement(pendingAreas.takeFirst().result());
+    }
+    areasSplicer.end();
     if (!file.commit()) {
         qDebug() << "TMap::writeJsonMapFile: error saving JSON map: " << file.errorString();
     }
@@ -3074,10 +3132,10 @@ std::pair<bool, QString> TMap::readJsonMapFile(const QString& source, const bool
                     : qsl("could not open file \"%1\"").arg(source))};
     }
 
-    const QByteArray mapData = file.readAll();
-    file.close();
     QJsonParseError jsonErr;
-    const QJsonDocument doc(QJsonDocument::fromJson(mapData, &jsonErr));
+    // The raw file contents are only needed until they have been parsed:
+    QJsonDocument doc(QJsonDocument::fromJson(file.readAll(), &jsonErr));
+    file.close();
     if (jsonErr.error != QJsonParseError::NoError) {
         return {false, (translatableTexts
                     ? tr("could not parse file, reason: \"%1\" at offset %2")
@@ -3095,6 +3153,8 @@ std::pair<bool, QString> TMap::readJsonMapFile(const QString& source, const bool
 
     // Read all the base level stuff:
     QJsonObject mapObj{doc.object()};
+    // Only mapObj needs to hold on to the parsed data from here on:
+    doc = QJsonDocument();
     double formatVersion = 0.0f;
     if (mapObj.contains(QLatin1String("formatVersion")) && mapObj[QLatin1String("formatVersion")].isDouble()) {
         formatVersion = mapObj[QLatin1String("formatVersion")].toDouble();
@@ -3220,9 +3280,22 @@ std::pair<bool, QString> TMap::readJsonMapFile(const QString& source, const bool
 
     TRoomDB* pNewRoomDB = new TRoomDB(this);
     bool abort = false;
-    for (int i = 0, total = mapObj.value(QLatin1String("areas")).toArray().count(); i < total; ++i) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    // Qt 6 holds each nested object separately so, once the areas have been
+    // taken out of mapObj, dropping each one from the array as soon as it has
+    // been read frees its parsed data straight away rather than after the
+    // whole map has been read. Qt 5 keeps one block for the whole document
+    // and would have to copy it to do the same:
+    QJsonArray areasArray{mapObj.take(QLatin1String("areas")).toArray()};
+#else
+    const QJsonArray areasArray{mapObj.value(QLatin1String("areas")).toArray()};
+#endif
+    for (int i = 0, total = areasArray.count(); i < total; ++i) {
         std::unique_ptr<TArea> pArea = std::make_unique<TArea>(this, pNewRoomDB);
-        auto [id, name] = pArea->readJsonArea(mapObj.value(QLatin1String("areas")).toArray(), i);
+        auto [id, name] = pArea->readJsonArea(areasArray, i);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        areasArray[i] = QJsonValue();
+#endif
         ++mProgressDialogAreasCount;
         if (incrementJsonProgressDialog(false, true, 0)) {
             if (allowUserCancellation) {
@@ -3412,6 +3485,11 @@ bool TMap::incrementJsonProgressDialog(const bool isExportNotImport, const bool
  */
 void TMap::update()
 {
+    if (mBatchUpdateDepth) {
+        mBatchNeedsRepaint = true;
+        return;
+    }
+
     static bool debounce;
     if (!debounce) {
         debounce = true;
@@ -3436,6 +3514,70 @@ void TMap::update()
     }
 }
 
+void TMap::beginBatchUpdate()
+{
+    if (!mBatchUpdateDepth++) {
+        // A script that errors out before its endMapUpdate() would otherwise
+        // leave the map unrefreshed - no batch should outlast the code that
+        // started it so close any that is still open on the next pass of the
+        // event loop:
+        QTimer::singleShot(0, this, [this]() {
+            if (mBatchUpdateDepth) {
+                QString msg = tr("A batch of map changes was not ended (is an endMapUpdate() missing?), it has been ended now.");
+                logError(msg);
+                mBatchUpdateDepth = 1;
+                endBatchUpdate();
+            }
+        });
+    }
+}
+
+void TMap::endBatchUpdate()
+{
+    if (!mBatchUpdateDepth || --mBatchUpdateDepth) {
+        return;
+    }
+
+    // Areas may have been deleted during the batch so only use the ones that
+    // are still present:
+    QSet<TArea*> recalculatedAreas;
+    for (const auto pA : mpRoomDB->getAreaMap()) {
+        if (mBatchDirtyAreas.contains(pA)) {
+            pA->calcSpan();
+            pA->determineAreaExits();
+            pA->mIsDirty = false;
+            recalculatedAreas.insert(pA);
+        }
+    }
+    for (const int roomId : qAsConst(mBatchDirtyRoomIds)) {
+        TRoom* pR = mpRoomDB->getRoom(roomId);
+        if (!pR) {
+            continue;
+        }
+        TArea* pA = mpRoomDB->getArea(pR->getArea());
+        if (pA && !recalculatedAreas.contains(pA)) {
+            pA->determineAreaExitsOfRoom(roomId);
+        }
+    }
+    mBatchDirtyAreas.clear();
+    mBatchDirtyRoomIds.clear();
+
+    if (mBatchNeedsRepaint) {
+        mBatchNeedsRepaint = false;
+        update();
+    }
+}
+
+void TMap::deferAreaRecalculation(TArea* pA)
+{
+    mBatchDirtyAreas.insert(pA);
+}
+
+void TMap::deferAreaExitsOfRoomRecalculation(const int roomId)
+{
+    mBatchDirtyRoomIds.insert(roomId);
+}
+
 QColor TMap::getColor(int id)
 {
     QColor color;
@@ -41,6 +41,7 @@
 #include <QNetworkReply>
 #include <QPixmap>
 #include <QPointer>
+#include <QSet>
 #include <QSizeF>
 #include <QVector3D>
 #include <stdlib.h>
@@ -118,6 +119,14 @@ public:
     bool setExit(int from, int to, int dir);
     bool setRoomCoordinates(int id, int x, int y, int z);
     void update();
+    // Changes made between these (which can be nested) put off working out
+    // area extents and exits, and repainting the map, until the outermost
+    // batch ends - see TMapBatchUpdate for a scoped form:
+    void beginBatchUpdate();
+    void endBatchUpdate();
+    bool isInBatchUpdate() const { return mBatchUpdateDepth > 0; }
+    void deferAreaRecalculation(TArea*);
+    void deferAreaExitsOfRoomRecalculation(int roomId);
 
     void audit();
 
@@ -386,6 +395,37 @@ private:
     // Used to hide the default area from casual viewing for those MUDs that
     // want to script a "fog-of-war" system by hiding rooms in the -1 area:
     bool mShowDefaultArea = true;
+
+    // What has been put off until the current batch update ends:
+    int mBatchUpdateDepth = 0;
+    QSet<TArea*> mBatchDirtyAreas;
+    QSet<int> mBatchDirtyRoomIds;
+    bool mBatchNeedsRepaint = false;
+};
+
+// Keeps a TMap in batch update mode for as long as it is in scope:
+class TMapBatchUpdate
+{
+public:
+    explicit TMapBatchUpdate(TMap* pMap)
+    : mpMap(pMap)
+    {
+        if (mpMap) {
+            mpMap->beginBatchUpdate();
+        }
+    }
+
+    ~TMapBatchUpdate()
+    {
+        if (mpMap) {
+            mpMap->endBatchUpdate();
+        }
+    }
+
+    Q_DISABLE_COPY(TMapBatchUpdate)
+
+private:
+    QPointer<TMap> mpMap;
 };
 
 #endif // MUDLET_TMAP_H
@@ -22,30 +22,48 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include "pre_guard.h"
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include "post_guard.h"
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using NameGroupMatches = QVector<QPair<QString, QString>>;
+
+// The progress of one partial match of a multi-line (AND) trigger; these are
+// recycled by a TMatchStatePool rather than being individually allocated for
+// every line that matches the first condition:
 class TMatchState
 {
 public:
-    TMatchState(int numberOfConditions, int delta)
-    : mNumberOfConditions(numberOfConditions)
-    , mDelta(delta)
-    {
-    }
-
-    // Copy constructor:
-    TMatchState(const TMatchState& ms)
-    : mNumberOfConditions(ms.mNumberOfConditions)
-    , mNextCondition(ms.mNextCondition)
-    , mLineCount(ms.mLineCount)
-    , mDelta(ms.mDelta)
-    , mSpacer(ms.mSpacer)
+    void reset(int numberOfConditions, int delta)
     {
+        mNumberOfConditions = numberOfConditions;
+        mNextCondition = 1;
+        mLineCount = 1;
+        mDelta = delta;
+        mSpacer = 0;
+        mIsToBeReclaimed = false;
+        // clear() keeps the capacity of the vectors so a recycled record does
+        // not need to allocate again:
+        mCaptures.clear();
+        mCapturePositions.clear();
+        mConditionEnds.clear();
+        nameCaptures.clear();
     }
 
-    int nextCondition() { return mNextCondition; }
+    int nextCondition() const { return mNextCondition; }
     void conditionMatched() { mNextCondition++; }
-    bool isComplete() { return (mNextCondition >= mNumberOfConditions); }
+    bool isComplete() const { return (mNextCondition >= mNumberOfConditions); }
     void newLineArrived() { mLineCount++; }
-    bool newLine() { return !(mLineCount > mDelta); }
+    bool newLine() const { return !(mLineCount > mDelta); }
 
     bool lineSpacerMatch(int lines)
     {
@@ -57,8 +75,38 @@ public:
         return false;
     }
 
-    std::list<std::list<std::string>> multiCaptureList;
-    std::list<std::list<int>> multiCapturePosList;
+    // Records the captures for the condition that has just been met:
+    void addCaptures(const std::list<std::string>& captureList, const std::list<int>& posList)
+    {
+        mCaptures.insert(mCaptures.end(), captureList.cbegin(), captureList.cend());
+        mCapturePositions.insert(mCapturePositions.end(), posList.cbegin(), posList.cend());
+        mConditionEnds.emplace_back(mCaptures.size(), mCapturePositions.size());
+    }
+
+    // The captures are held flat and only split back up into one list per
+    // condition when the trigger actually fires:
+    std::list<std::list<std::string>> multiCaptureList() const
+    {
+        std::list<std::list<std::string>> result;
+        size_t begin = 0;
+        for (const auto& [captureEnd, positionEnd] : mConditionEnds) {
+            result.emplace_back(mCaptures.cbegin() + begin, mCaptures.cbegin() + captureEnd);
+            begin = captureEnd;
+        }
+        return result;
+    }
+
+    std::list<std::list<int>> multiCapturePosList() const
+    {
+        std::list<std::list<int>> result;
+        size_t begin = 0;
+        for (const auto& [captureEnd, positionEnd] : mConditionEnds) {
+            result.emplace_back(mCapturePositions.cbegin() + begin, mCapturePositions.cbegin() + positionEnd);
+            begin = positionEnd;
+        }
+        return result;
+    }
+
     QVector<NameGroupMatches> nameCaptures;
     int mNumberOfConditions = 0;
     // first condition was true when the state was created
@@ -66,6 +114,82 @@ public:
     int mLineCount = 1;
     int mDelta = 0;
     int mSpacer = 0;
+    // Set once the state has fired or timed out, the owning pool will then
+    // recycle it on the next TMatchStatePool::reclaim():
+    bool mIsToBeReclaimed = false;
+
+private:
+    std::vector<std::string> mCaptures;
+    std::vector<int> mCapturePositions;
+    // For each condition met so far, the end offsets into the above:
+    std::vector<std::pair<size_t, size_t>> mConditionEnds;
+};
+
+// Owns the TMatchStates of one multi-line trigger; the active ones are kept in
+// creation order at the front of mStates and the ones after that are spares
+// waiting to be reused:
+class TMatchStatePool
+{
+public:
+    // A trigger with overlapping partial matches (long who lists, loot lists,
+    // etc.) could otherwise accumulate an unbounded number of them:
+    static constexpr size_t csmMaxActiveStates = 1000;
+
+    // Returns a fresh state for a new partial match, if the limit has been
+    // reached the oldest active one is dropped to make room and true is
+    // returned as the second value:
+    std::pair<TMatchState*, bool> acquire(int numberOfConditions, int delta)
+    {
+        bool evicted = false;
+        if (mActiveCount >= csmMaxActiveStates) {
+            // Move the oldest to the end of the active range and then out of it:
+            std::rotate(mStates.begin(), mStates.begin() + 1, mStates.begin() + mActiveCount);
+            --mActiveCount;
+            evicted = true;
+        }
+        if (mActiveCount == mStates.size()) {
+            mStates.push_back(std::make_unique<TMatchState>());
+        }
+        TMatchState* pState = mStates.at(mActiveCount++).get();
+        pState->reset(numberOfConditions, delta);
+        return {pState, evicted};
+    }
+
+    // Returns every state that has been flagged with mIsToBeReclaimed to the
+    // spares in one pass, keeping the survivors in their original order:
+    void reclaim()
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < mActiveCount; ++i) {
+            if (!mStates.at(i)->mIsToBeReclaimed) {
+                if (i != kept) {
+                    std::swap(mStates[i], mStates[kept]);
+                }
+                ++kept;
+            }
+        }
+        mActiveCount = kept;
+        // Don't hang on to a large number of spares after a burst:
+        if (mStates.size() > mActiveCount + csmMaxSpareStates) {
+            mStates.resize(mActiveCount + csmMaxSpareStates);
+        }
+    }
+
+    void clear()
+    {
+        mStates.clear();
+        mActiveCount = 0;
+    }
+
+    size_t size() const { return mActiveCount; }
+    bool empty() const { return !mActiveCount; }
+    TMatchState* at(size_t index) const { return mStates.at(index).get(); }
+
+private:
+    static constexpr size_t csmMaxSpareStates = 32;
+
+    std::vector<std::unique_ptr<TMatchState>> mStates;
+    size_t mActiveCount = 0;
 };
 
 #endif // MUDLET_TMATCHSTATE_H
@@ -0,0 +1,85 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by The Mudlet Developers - mudlet.org              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "TProfiler.h"
+
+
+void TProfiler::setEnabled(const bool state)
+{
+    mEnabled = state;
+}
+
+void TProfiler::reset()
+{
+    mItemStats.clear();
+    mHandlerStats.clear();
+    mRecordedTime = 0;
+}
+
+QList<TProfiler::Stats> TProfiler::getStats() const
+{
+    return mItemStats.values() + mHandlerStats.values();
+}
+
+QString TProfiler::typeName(const ItemType type)
+{
+    switch (type) {
+    case Trigger:       return QLatin1String("trigger");
+    case Alias:         return QLatin1String("alias");
+    case Timer:         return QLatin1String("timer");
+    case Key:           return QLatin1String("key");
+    case Script:        return QLatin1String("script");
+    case EventHandler:  return QLatin1String("event handler");
+    case GmcpHandler:   return QLatin1String("gmcp handler");
+    }
+    Q_UNREACHABLE();
+    return QString();
+}
+
+void TProfiler::record(const ItemType type, const int id, const QString& name, const bool isMatch, const qint64 selfTime)
+{
+    Stats& stats = (id >= 0) ? mItemStats[qMakePair(static_cast<int>(type), id)]
+                             : mHandlerStats[qMakePair(static_cast<int>(type), name)];
+    stats.mType = type;
+    stats.mId = id;
+    // Items can be renamed whilst being profiled:
+    stats.mName = name;
+    stats.mTotalTime += selfTime;
+    stats.mMaxTime = qMax(stats.mMaxTime, selfTime);
+    if (isMatch) {
+        stats.mMatchTime += selfTime;
+    } else {
+        ++stats.mCalls;
+        stats.mScriptTime += selfTime;
+    }
+    mRecordedTime += selfTime;
+}
+
+TProfilerSample::~TProfilerSample()
+{
+    if (Q_LIKELY(!mIsActive)) {
+        return;
+    }
+    // Anything recorded since we started was by profiled items that were
+    // called from within this one, so do not count that again here:
+    const qint64 nestedTime = mProfiler.mRecordedTime - mRecordedAtStart;
+    const qint64 selfTime = qMax(Q_INT64_C(0), mTimer.nsecsElapsed() - nestedTime);
+    mProfiler.record(mType, mId, mName, mKind == Match, selfTime);
+}
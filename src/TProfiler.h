@@ -0,0 +1,121 @@
+#ifndef MUDLET_TPROFILER_H
+#define MUDLET_TPROFILER_H
+
+/***************************************************************************
+ *   Copyright (C) 2026 by The Mudlet Developers - mudlet.org              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "pre_guard.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include "post_guard.h"
+
+// Collects per item timing information for the triggers, aliases, timers, keys
+// and event handlers of a profile so that the ones that are slowing things
+// down can be found. When it is not enabled the only cost is the check of the
+// flag in TProfilerSample.
+class TProfiler
+{
+public:
+    enum ItemType {
+        Trigger = 0,
+        Alias,
+        Timer,
+        Key,
+        Script,
+        // Anonymous (registerAnonymousEventHandler(...)) handlers for
+        // anything other than GMCP:
+        EventHandler,
+        // Anonymous handlers for gmcp.* events:
+        GmcpHandler
+    };
+
+    struct Stats
+    {
+        ItemType mType = Trigger;
+        // The item's ID, or -1 for anonymous event handlers which don't have one:
+        int mId = -1;
+        QString mName;
+        quint64 mCalls = 0;
+        // Times are in nanoseconds and exclude any time spent in other
+        // profiled items called from this one:
+        qint64 mTotalTime = 0;
+        qint64 mMaxTime = 0;
+        // Split of the above between pattern matching and running Lua code:
+        qint64 mMatchTime = 0;
+        qint64 mScriptTime = 0;
+    };
+
+    bool isEnabled() const { return mEnabled; }
+    void setEnabled(const bool);
+    void reset();
+    QList<Stats> getStats() const;
+    static QString typeName(ItemType);
+
+private:
+    friend class TProfilerSample;
+
+    void record(ItemType, int id, const QString& name, bool isMatch, qint64 selfTime);
+
+    bool mEnabled = false;
+    // Total time recorded so far, used by nested samples to work out how much
+    // of their elapsed time was spent in other profiled items:
+    qint64 mRecordedTime = 0;
+    QHash<QPair<int, int>, Stats> mItemStats;
+    QHash<QPair<int, QString>, Stats> mHandlerStats;
+};
+
+// Scoped timer, create one on the stack for the duration of the code to be
+// measured - if the profiler is disabled it does nothing else:
+class TProfilerSample
+{
+public:
+    enum Kind { Match, Run };
+
+    TProfilerSample(TProfiler& profiler, TProfiler::ItemType type, int id, const QString& name, Kind kind)
+    : mProfiler(profiler)
+    , mIsActive(profiler.isEnabled())
+    {
+        if (Q_LIKELY(!mIsActive)) {
+            return;
+        }
+        mType = type;
+        mId = id;
+        mName = name;
+        mKind = kind;
+        mRecordedAtStart = profiler.mRecordedTime;
+        mTimer.start();
+    }
+    ~TProfilerSample();
+    Q_DISABLE_COPY(TProfilerSample)
+
+private:
+    TProfiler& mProfiler;
+    const bool mIsActive;
+    TProfiler::ItemType mType = TProfiler::Trigger;
+    int mId = -1;
+    QString mName;
+    Kind mKind = Run;
+    qint64 mRecordedAtStart = 0;
+    QElapsedTimer mTimer;
+};
+
+#endif // MUDLET_TPROFILER_H
@@ -0,0 +1,88 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by The Mudlet Developers - mudlet.org              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "TRegexCache.h"
+
+#include "pre_guard.h"
+#include <QMutexLocker>
+#include "post_guard.h"
+
+#include <algorithm>
+
+static void pcre_deleter(pcre* pointer)
+{
+    pcre_free(pointer);
+}
+
+TRegexCache& TRegexCache::self()
+{
+    static TRegexCache instance;
+    return instance;
+}
+
+QSharedPointer<pcre> TRegexCache::compile(const QByteArray& pattern, const char** error)
+{
+    TRegexCache& cache = self();
+    QMutexLocker locker(&cache.mMutex);
+
+    auto it = cache.mPatterns.find(pattern);
+    if (it != cache.mPatterns.end()) {
+        QSharedPointer<pcre> shared = it.value().toStrongRef();
+        if (shared) {
+            return shared;
+        }
+    }
+
+    int erroffset;
+    // PCRE_UTF8 needed to run compile in UTF-8 mode
+    // PCRE_UCP needed for \d, \w etc. to use Unicode properties:
+    QSharedPointer<pcre> const re(pcre_compile(pattern.constData(), PCRE_UTF8 | PCRE_UCP, error, &erroffset, nullptr), pcre_deleter);
+    if (!re) {
+        return re;
+    }
+
+    cache.mPatterns.insert(pattern, re.toWeakRef());
+    if (cache.mPatterns.size() > cache.mPruneThreshold) {
+        cache.pruneExpired();
+    }
+    return re;
+}
+
+bool TRegexCache::isCached(const QByteArray& pattern)
+{
+    TRegexCache& cache = self();
+    QMutexLocker locker(&cache.mMutex);
+    return !cache.mPatterns.value(pattern).isNull();
+}
+
+// Only called with mMutex held:
+void TRegexCache::pruneExpired()
+{
+    auto it = mPatterns.begin();
+    while (it != mPatterns.end()) {
+        if (it.value().isNull()) {
+            it = mPatterns.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    // Let the table double in live size before the next sweep so that the
+    // cost of sweeping stays proportional to the number of insertions:
+    mPruneThreshold = std::max(csmInitialPruneThreshold, static_cast<int>(mPatterns.size()) * 2);
+}
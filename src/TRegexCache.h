@@ -0,0 +1,61 @@
+#ifndef MUDLET_TREGEXCACHE_H
+#define MUDLET_TREGEXCACHE_H
+
+/***************************************************************************
+ *   Copyright (C) 2026 by The Mudlet Developers - mudlet.org              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "pre_guard.h"
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QWeakPointer>
+#include "post_guard.h"
+
+#include <pcre.h>
+
+// A process-wide store of compiled PCRE patterns. A compiled pattern is never
+// modified once pcre_compile() has produced it, so every trigger and alias -
+// in every open profile - that uses the same pattern text can share a single
+// copy. Only weak references are kept here so a pattern is freed as soon as
+// the last item using it is recompiled or destroyed:
+class TRegexCache
+{
+public:
+    // Returns a null pointer and sets error (a static string owned by PCRE)
+    // if the pattern does not compile; failures are not cached:
+    static QSharedPointer<pcre> compile(const QByteArray& pattern, const char** error);
+    // True if a compiled copy of the pattern is still in use somewhere:
+    static bool isCached(const QByteArray& pattern);
+
+private:
+    TRegexCache() = default;
+
+    void pruneExpired();
+
+    static TRegexCache& self();
+
+    QMutex mMutex;
+    QHash<QByteArray, QWeakPointer<pcre>> mPatterns;
+    // Expired entries are swept out when the table grows past this size:
+    int mPruneThreshold = csmInitialPruneThreshold;
+    static constexpr int csmInitialPruneThreshold = 256;
+};
+
+#endif // MUDLET_TREGEXCACHE_H
@@ -120,6 +120,47 @@ QString TRoom::dirCodeToDisplayName(const int dirCode) const
     }
 }
 
+/* static */ int TRoom::shortStringToDirCode(const QString& string)
+{
+    if (string == QLatin1String("n")) {
+        return DIR_NORTH;
+    }
+    if (string == QLatin1String("e")) {
+        return DIR_EAST;
+    }
+    if (string == QLatin1String("s")) {
+        return DIR_SOUTH;
+    }
+    if (string == QLatin1String("w")) {
+        return DIR_WEST;
+    }
+    if (string == QLatin1String("up")) {
+        return DIR_UP;
+    }
+    if (string == QLatin1String("down")) {
+        return DIR_DOWN;
+    }
+    if (string == QLatin1String("ne")) {
+        return DIR_NORTHEAST;
+    }
+    if (string == QLatin1String("nw")) {
+        return DIR_NORTHWEST;
+    }
+    if (string == QLatin1String("se")) {
+        return DIR_SOUTHEAST;
+    }
+    if (string == QLatin1String("sw")) {
+        return DIR_SOUTHWEST;
+    }
+    if (string == QLatin1String("in")) {
+        return DIR_IN;
+    }
+    if (string == QLatin1String("out")) {
+        return DIR_OUT;
+    }
+    return DIR_OTHER;
+}
+
 /* static */ QString TRoom::dirCodeToString(const int dirCode)
 {
     switch (dirCode) {
@@ -180,13 +221,24 @@ int TRoom::stringToDirCode(const QString& string) const
     return DIR_OTHER;
 }
 
-bool TRoom::hasExitStub(int direction)
+bool TRoom::hasExitStub(int direction) const
 {
-    if (exitStubs.contains(direction)) {
-        return true;
-    } else {
+    if (direction < DIR_NORTH || direction > DIR_OUT) {
         return false;
     }
+    return mExitFlags[direction] & ExitStub;
+}
+
+// Bit (1 << DIR_*) is set for each normal exit direction that has a stub:
+quint16 TRoom::getExitStubMask() const
+{
+    quint16 mask = 0;
+    for (int direction = DIR_NORTH; direction <= DIR_OUT; ++direction) {
+        if (mExitFlags[direction] & ExitStub) {
+            mask |= (1 << direction);
+        }
+    }
+    return mask;
 }
 
 void TRoom::setExitStub(int direction, bool status)
@@ -205,6 +257,7 @@ void TRoom::setExitStub(int direction, bool status)
     } else {
         exitStubs.removeAll(direction);
     }
+    syncExitTableEntry(direction);
     mpRoomDB->mpMap->setUnsaved(__func__);
 }
 
@@ -217,6 +270,25 @@ int TRoom::getExitWeight(const QString& cmd)
     }
 }
 
+int TRoom::getExitWeight(const int direction) const
+{
+    if (direction < DIR_NORTH || direction > DIR_OUT || !(mExitFlags[direction] & ExitWeighted)) {
+        return weight; // NOTE: if no exit weight has been set: exit weight = room weight
+    }
+    return mExitWeights[direction];
+}
+
+// Returns the given value rather than the weight of this room if no exit
+// specific weight has been set - route finding uses the weight of the
+// destination room in that case:
+int TRoom::getExitWeight(const int direction, const int defaultWeight) const
+{
+    if (direction < DIR_NORTH || direction > DIR_OUT || !(mExitFlags[direction] & ExitWeighted)) {
+        return defaultWeight;
+    }
+    return mExitWeights[direction];
+}
+
 // NOTE: needed so dialogRoomExit code can tell if an exit weight has been set
 // now that they are private!
 bool TRoom::hasExitWeight(const QString& cmd)
@@ -245,10 +317,12 @@ void TRoom::setExitWeight(const QString& cmd, int w)
 {
     if (w > 0) {
         exitWeights[cmd] = w;
+        syncExitTableEntry(cmd);
         mpRoomDB->mpMap->setUnsaved(__func__);
         mpRoomDB->mpMap->mMapGraphNeedsUpdate = true;
     } else if (exitWeights.contains(cmd)) {
         exitWeights.remove(cmd);
+        syncExitTableEntry(cmd);
         mpRoomDB->mpMap->setUnsaved(__func__);
         mpRoomDB->mpMap->mMapGraphNeedsUpdate = true;
     }
@@ -264,6 +338,7 @@ bool TRoom::setDoor(const QString& cmd, const int doorStatus)
         if (doors.value(cmd, 0) != doorStatus) {
             // .value will return 0 if there ISN'T a door for this cmd
             doors[cmd] = doorStatus;
+            syncExitTableEntry(cmd);
             mpRoomDB->mpMap->setUnsaved(__func__);
             return true; // As we have changed things
         } else {
@@ -271,6 +346,7 @@ bool TRoom::setDoor(const QString& cmd, const int doorStatus)
         }
     } else if (doors.contains(cmd) && !doorStatus) {
         doors.remove(cmd);
+        syncExitTableEntry(cmd);
         mpRoomDB->mpMap->setUnsaved(__func__);
         return true; // As we have changed things
     } else {
@@ -284,11 +360,102 @@ int TRoom::getDoor(const QString& cmd) const
     // Second argument is the result if cmd is not in the doors QMap
 }
 
+int TRoom::getDoor(const int direction) const
+{
+    if (direction < DIR_NORTH || direction > DIR_OUT) {
+        return 0;
+    }
+    return (mExitFlags[direction] & ExitDoorMask) >> ExitDoorShift;
+}
+
+void TRoom::syncExitTableEntry(const int direction)
+{
+    if (direction < DIR_NORTH || direction > DIR_OUT) {
+        return;
+    }
+
+    const QString key{dirCodeToShortString(direction)};
+    quint8 flags = 0;
+    if (exitLocks.contains(direction)) {
+        flags |= ExitLocked;
+    }
+    if (exitStubs.contains(direction)) {
+        flags |= ExitStub;
+    }
+    flags |= (qBound(0, doors.value(key, 0), 3) << ExitDoorShift) & ExitDoorMask;
+    // Like getExitWeight(const QString&) it is whether there is an entry,
+    // not its value, that decides if the room weight is used instead:
+    if (exitWeights.contains(key)) {
+        flags |= ExitWeighted;
+        mExitWeights[direction] = exitWeights.value(key);
+    } else {
+        mExitWeights[direction] = 0;
+    }
+    mExitFlags[direction] = flags;
+}
+
+// Special exits can share the keys used for the doors and weights of the normal
+// exits so this is called whenever one of those is touched by name:
+void TRoom::syncExitTableEntry(const QString& cmd)
+{
+    syncExitTableEntry(shortStringToDirCode(cmd));
+}
+
+void TRoom::rebuildExitTable()
+{
+    for (int direction = DIR_NORTH; direction <= DIR_OUT; ++direction) {
+        syncExitTableEntry(direction);
+    }
+}
+
 void TRoom::setId(const int roomId)
 {
     id = roomId;
 }
 
+void TRoom::setName(const QString& newName)
+{
+    if (name == newName) {
+        return;
+    }
+    const QString oldName = name;
+    name = newName;
+    mpRoomDB->roomNameChanged(this, oldName);
+}
+
+void TRoom::setUserData(const QString& key, const QString& value)
+{
+    // A null QString is used to indicate a key that is not present:
+    const QString oldValue = userData.value(key, QString());
+    userData.insert(key, value);
+    if (oldValue.isNull() || oldValue != value) {
+        mpRoomDB->roomUserDataChanged(this, key, oldValue);
+    }
+}
+
+bool TRoom::removeUserData(const QString& key)
+{
+    if (!userData.contains(key)) {
+        return false;
+    }
+    const QString oldValue = userData.take(key);
+    mpRoomDB->roomUserDataChanged(this, key, oldValue);
+    return true;
+}
+
+bool TRoom::clearUserData()
+{
+    if (userData.isEmpty()) {
+        return false;
+    }
+    const QMap<QString, QString> oldUserData = userData;
+    userData.clear();
+    for (auto itOldUserData = oldUserData.cbegin(); itOldUserData != oldUserData.cend(); ++itOldUserData) {
+        mpRoomDB->roomUserDataChanged(this, itOldUserData.key(), itOldUserData.value());
+    }
+    return true;
+}
+
 // The second optional argument delays area related recaluclations when true
 // until called with false (the default) - it records the "dirty" areas so that
 // the affected areas can be identified.
@@ -523,6 +690,7 @@ void TRoom::setExitLock(int exit, bool state)
     } else {
         exitLocks.removeAll(exit);
     }
+    syncExitTableEntry(exit);
     mpRoomDB->mpMap->setUnsaved(__func__);
 }
 
@@ -544,7 +712,22 @@ bool TRoom::setSpecialExitLock(const QString& cmd, const bool doLock)
 
 bool TRoom::hasExitLock(const int dir) const
 {
-    return exitLocks.contains(dir);
+    if (dir < DIR_NORTH || dir > DIR_OUT) {
+        return false;
+    }
+    return mExitFlags[dir] & ExitLocked;
+}
+
+// Bit (1 << DIR_*) is set for each normal exit direction that is locked:
+quint16 TRoom::getExitLockMask() const
+{
+    quint16 mask = 0;
+    for (int direction = DIR_NORTH; direction <= DIR_OUT; ++direction) {
+        if (mExitFlags[direction] & ExitLocked) {
+            mask |= (1 << direction);
+        }
+    }
+    return mask;
 }
 
 bool TRoom::hasSpecialExitLock(const QString& cmd) const
@@ -575,6 +758,7 @@ void TRoom::setSpecialExit(const int to, const QString& cmd)
         doors.remove(cmd);
         mSpecialExitLocks.remove(cmd);
         mSpecialExits.remove(cmd);
+        syncExitTableEntry(cmd);
     }
 
     TArea* pA = mpRoomDB->getArea(area);
@@ -599,6 +783,7 @@ void TRoom::clearSpecialExits()
         // Clean up related elements first:
         mSpecialExitLocks.remove(itSpecialExit.key());
         doors.remove(itSpecialExit.key());
+        syncExitTableEntry(itSpecialExit.key());
         customLines.remove(itSpecialExit.key());
         customLinesColor.remove(itSpecialExit.key());
         customLinesStyle.remove(itSpecialExit.key());
@@ -625,6 +810,7 @@ void TRoom::removeAllSpecialExitsToRoom(const int roomId)
         // Clean up related elements first:
         mSpecialExitLocks.remove(itSpecialExit.key());
         doors.remove(itSpecialExit.key());
+        syncExitTableEntry(itSpecialExit.key());
         customLines.remove(itSpecialExit.key());
         customLinesColor.remove(itSpecialExit.key());
         customLinesStyle.remove(itSpecialExit.key());
@@ -926,6 +1112,7 @@ void TRoom::restore(QDataStream& ifs, int roomID, int version)
         ifs >> exitWeights;
         ifs >> doors;
     }
+    rebuildExitTable();
     calcRoomDimensions();
 }
 
@@ -1442,6 +1629,9 @@ void TRoom::auditExits(const QHash<int, int> roomRemapping)
             mpRoomDB->mpMap->appendRoomErrorMsg(id, tr("[ INFO ]  - Room had one or more surplus custom line elements that were removed: %1.").arg(extras.join(QLatin1String(", "))), true);
         }
     }
+
+    // The above may have removed any of the exit locks/stubs/doors/weights:
+    rebuildExitTable();
 }
 
 void TRoom::auditExit(int& exitRoomId,                     // Reference to where exit goes to
@@ -1787,6 +1977,7 @@ int TRoom::readJsonRoom(const QJsonArray& array, const int index, const int area
     }
 
     readJsonExitStubs(roomObj);
+    rebuildExitTable();
 
     return roomId;
 }
@@ -36,6 +36,8 @@
 #include <QVector3D>
 #include "post_guard.h"
 
+#include <array>
+
 class XMLimport;
 class XMLexport;
 class TRoomDB;
@@ -59,6 +61,7 @@ public:
     void setExitLock(const int, const bool);
     bool setSpecialExitLock(const QString&, const bool);
     bool hasExitLock(const int to) const;
+    quint16 getExitLockMask() const;
     bool hasSpecialExitLock(const QString&) const;
     void removeAllSpecialExitsToRoom(const int);
     void setSpecialExit(const int, const QString&);
@@ -70,7 +73,12 @@ public:
     bool hasExitWeight(const QString& cmd);
     bool setDoor(const QString& cmd, int doorStatus); //0=no door, 1=open door, 2=closed, 3=locked
     int getDoor(const QString& cmd) const;
-    bool hasExitStub(int direction);
+    // Fast path versions for the normal exits (DIR_NORTH to DIR_OUT):
+    int getDoor(const int direction) const;
+    int getExitWeight(const int direction) const;
+    int getExitWeight(const int direction, const int defaultWeight) const;
+    bool hasExitStub(int direction) const;
+    quint16 getExitStubMask() const;
     void setExitStub(int direction, bool status);
     void calcRoomDimensions();
     bool setArea(int, bool isToDeferAreaRelatedRecalculations = false);
@@ -122,10 +130,17 @@ public:
     QString dirCodeToDisplayName(int) const;
     static QString dirCodeToShortString(const int);
     static QString dirCodeToString(const int);
+    static int shortStringToDirCode(const QString&);
     inline int stringToDirCode(const QString&) const;
     bool hasExitOrSpecialExit(const QString&) const;
     void writeJsonRoom(QJsonArray&) const;
     int readJsonRoom(const QJsonArray&, const int, const int);
+    // These keep the TRoomDB search indexes up to date, so should be used
+    // rather than changing the name or userData members directly:
+    void setName(const QString&);
+    void setUserData(const QString& key, const QString& value);
+    bool removeUserData(const QString& key);
+    bool clearUserData();
 
 
     int x = 0;
@@ -181,6 +196,10 @@ private:
     void writeJsonHighlight(QJsonObject&) const;
     void writeJsonSymbol(QJsonObject&) const;
 
+    void syncExitTableEntry(const int direction);
+    void syncExitTableEntry(const QString& cmd);
+    void rebuildExitTable();
+
 
     int id = 0;
     int area = -1;
@@ -203,6 +222,25 @@ private:
     QMap<QString, int> mSpecialExits;
     QSet<QString> mSpecialExitLocks;
 
+    // Compact copy of the lock, stub, door and weight details for the normal
+    // exits, indexed by DIR_* code so that route finding and the 2D mapper do
+    // not have to do a string keyed QMap/QList lookup for each exit of each
+    // room. The exitLocks, exitStubs, doors and exitWeights members remain the
+    // canonical (and saved) form and this is kept in step with them by the
+    // setters and by rebuildExitTable() after bulk loads/audits:
+    enum ExitTableFlag : quint8 {
+        ExitLocked = 0x01,
+        ExitStub = 0x02,
+        // Door status (0-3) is held in the next two bits:
+        ExitDoorShift = 2,
+        ExitDoorMask = 0x0C,
+        // An exit specific weight has been set - even if it is 0:
+        ExitWeighted = 0x10
+    };
+    std::array<quint8, DIR_OUT + 1> mExitFlags{};
+    // Only meaningful where ExitWeighted is set:
+    std::array<int, DIR_OUT + 1> mExitWeights{};
+
     TRoomDB* mpRoomDB = nullptr;
     friend class XMLimport;
     friend class XMLexport;
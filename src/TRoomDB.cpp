@@ -30,6 +30,7 @@
 #include "pre_guard.h"
 #include <QElapsedTimer>
 #include <QRegularExpression>
+#include <QStringList>
 #include "post_guard.h"
 
 const QString ROOM_UI_SHOWNAME = qsl("room.ui_showName");
@@ -63,7 +64,8 @@ bool TRoomDB::addRoom(int id)
     if (!rooms.contains(id) && id > 0) {
         rooms[id] = new TRoom(this);
         rooms[id]->setId(id);
-        // there is no point in updating the entranceMap here, as the room has no exit information
+        // there is no point in updating the entrance map here, as the room has no exit information
+        addRoomToSearchIndexes(rooms[id]);
         return true;
     } else {
         if (id <= 0) {
@@ -80,24 +82,26 @@ bool TRoomDB::addRoom(int id, TRoom* pR, bool isMapLoading)
         rooms[id] = pR;
         pR->setId(id);
         updateEntranceMap(pR, isMapLoading);
+        addRoomToSearchIndexes(pR);
         return true;
     } else {
         return false;
     }
 }
 
+// Removes the record of all the exits FROM the given room:
 void TRoomDB::deleteValuesFromEntranceMap(int value)
 {
-    QList<int> const keyList = entranceMap.keys();
-    QList<int> const valueList = entranceMap.values();
-    QList<uint> deleteEntries;
-    int index = valueList.indexOf(value);
-    while (index != -1) {
-        deleteEntries.append(index);
-        index = valueList.indexOf(value, index + 1);
-    }
-    for (int i = deleteEntries.size() - 1; i >= 0; --i) {
-        entranceMap.remove(keyList.at(deleteEntries.at(i)), valueList.at(deleteEntries.at(i)));
+    const QSet<int> targets = mExitTargets.take(value);
+    for (const int target : targets) {
+        auto itEntrance = mEntrances.find(target);
+        if (itEntrance == mEntrances.end()) {
+            continue;
+        }
+        itEntrance.value().remove(value);
+        if (itEntrance.value().isEmpty()) {
+            mEntrances.erase(itEntrance);
+        }
     }
 }
 
@@ -105,20 +109,197 @@ void TRoomDB::deleteValuesFromEntranceMap(QSet<int>& valueSet)
 {
     QElapsedTimer timer;
     timer.start();
-    QList<int> const keyList = entranceMap.keys();
-    QList<int> const valueList = entranceMap.values();
-    QList<uint> deleteEntries;
-    for (auto roomId : valueSet) {
-        int index = valueList.indexOf(roomId);
-        while (index >= 0) {
-            deleteEntries.append(index);
-            index = valueList.indexOf(roomId, index + 1);
+    for (const int roomId : qAsConst(valueSet)) {
+        deleteValuesFromEntranceMap(roomId);
+    }
+    qDebug() << "TRoomDB::deleteValuesFromEntranceMap() with a list of:" << valueSet.size() << "items, run time:" << timer.nsecsElapsed() * 1.0e-9 << "sec.";
+}
+
+// Removes the record of all the exits TO the given room:
+void TRoomDB::deleteKeysFromEntranceMap(const int id)
+{
+    const QSet<int> sources = mEntrances.take(id);
+    for (const int source : sources) {
+        auto itExitTargets = mExitTargets.find(source);
+        if (itExitTargets == mExitTargets.end()) {
+            continue;
+        }
+        itExitTargets.value().remove(id);
+        if (itExitTargets.value().isEmpty()) {
+            mExitTargets.erase(itExitTargets);
         }
     }
-    for (unsigned const int entry : deleteEntries) {
-        entranceMap.remove(keyList.at(entry), valueList.at(entry));
+}
+
+QList<int> TRoomDB::getEntrances(const int id) const
+{
+    const QSet<int> sources = mEntrances.value(id);
+    return QList<int>{sources.cbegin(), sources.cend()};
+}
+
+void TRoomDB::invalidateSearchIndexes()
+{
+    mSearchIndexesAreValid = false;
+    mRoomNameIndex.clear();
+    mRoomUserDataIndex.clear();
+}
+
+void TRoomDB::buildSearchIndexes()
+{
+    QElapsedTimer timer;
+    timer.start();
+    mRoomNameIndex.clear();
+    mRoomUserDataIndex.clear();
+    mSearchIndexesAreValid = true;
+    for (auto pR : qAsConst(rooms)) {
+        addRoomToSearchIndexes(pR);
     }
-    qDebug() << "TRoomDB::deleteValuesFromEntranceMap() with a list of:" << valueSet.size() << "items, run time:" << timer.nsecsElapsed() * 1.0e-9 << "sec.";
+    qDebug().nospace().noquote() << "TRoomDB::buildSearchIndexes() INFO - indexed " << rooms.size() << " rooms with " << mRoomNameIndex.size() << " distinct names and " << mRoomUserDataIndex.size() << " user data keys in " << timer.nsecsElapsed() * 1.0e-6 << " ms.";
+}
+
+void TRoomDB::addRoomToSearchIndexes(TRoom* pR)
+{
+    if (!mSearchIndexesAreValid || !pR) {
+        return;
+    }
+    const int id = pR->getId();
+    mRoomNameIndex[pR->name.toCaseFolded()].insert(id);
+    for (auto itUserData = pR->userData.cbegin(); itUserData != pR->userData.cend(); ++itUserData) {
+        mRoomUserDataIndex[itUserData.key()][itUserData.value()].insert(id);
+    }
+}
+
+// Must be called after the room has been taken out of the rooms hash:
+void TRoomDB::removeRoomFromSearchIndexes(TRoom* pR)
+{
+    if (!mSearchIndexesAreValid || !pR) {
+        return;
+    }
+    const int id = pR->getId();
+    auto itName = mRoomNameIndex.find(pR->name.toCaseFolded());
+    if (itName != mRoomNameIndex.end()) {
+        itName.value().remove(id);
+        if (itName.value().isEmpty()) {
+            mRoomNameIndex.erase(itName);
+        }
+    }
+    for (auto itUserData = pR->userData.cbegin(); itUserData != pR->userData.cend(); ++itUserData) {
+        roomUserDataChanged(pR, itUserData.key(), itUserData.value());
+    }
+}
+
+void TRoomDB::roomNameChanged(TRoom* pR, const QString& oldName)
+{
+    if (!mSearchIndexesAreValid || !pR) {
+        return;
+    }
+    const int id = pR->getId();
+    auto itName = mRoomNameIndex.find(oldName.toCaseFolded());
+    if (itName != mRoomNameIndex.end()) {
+        itName.value().remove(id);
+        if (itName.value().isEmpty()) {
+            mRoomNameIndex.erase(itName);
+        }
+    }
+    if (rooms.value(id) == pR) {
+        mRoomNameIndex[pR->name.toCaseFolded()].insert(id);
+    }
+}
+
+// The room's entry for the old value (if it is not null) is removed and one
+// for the current value (if the key is still present) is added:
+void TRoomDB::roomUserDataChanged(TRoom* pR, const QString& key, const QString& oldValue)
+{
+    if (!mSearchIndexesAreValid || !pR) {
+        return;
+    }
+    const int id = pR->getId();
+    if (!oldValue.isNull()) {
+        auto itKey = mRoomUserDataIndex.find(key);
+        if (itKey != mRoomUserDataIndex.end()) {
+            auto itValue = itKey.value().find(oldValue);
+            if (itValue != itKey.value().end()) {
+                itValue.value().remove(id);
+                if (itValue.value().isEmpty()) {
+                    itKey.value().erase(itValue);
+                }
+            }
+            if (itKey.value().isEmpty()) {
+                mRoomUserDataIndex.erase(itKey);
+            }
+        }
+    }
+    // Check the room itself rather than trusting the caller, as this is also
+    // used to remove all the entries for a room that is being deleted:
+    if (rooms.value(id) == pR && pR->userData.contains(key)) {
+        mRoomUserDataIndex[key][pR->userData.value(key)].insert(id);
+    }
+}
+
+QList<int> TRoomDB::searchRoomsByName(const QString& name, const bool caseSensitive, const bool exactMatch)
+{
+    if (!mSearchIndexesAreValid) {
+        buildSearchIndexes();
+    }
+
+    QList<int> results;
+    const QString foldedName = name.toCaseFolded();
+    if (exactMatch) {
+        const QSet<int> candidates = mRoomNameIndex.value(foldedName);
+        for (const int id : candidates) {
+            if (caseSensitive) {
+                TRoom* pR = rooms.value(id);
+                if (!pR || pR->name != name) {
+                    continue;
+                }
+            }
+            results.append(id);
+        }
+        return results;
+    }
+
+    // A substring search still has to look at every distinct name, but there
+    // are usually far fewer of those than there are rooms:
+    for (auto itName = mRoomNameIndex.cbegin(); itName != mRoomNameIndex.cend(); ++itName) {
+        if (!itName.key().contains(foldedName)) {
+            continue;
+        }
+        for (const int id : itName.value()) {
+            if (caseSensitive) {
+                TRoom* pR = rooms.value(id);
+                if (!pR || !pR->name.contains(name)) {
+                    continue;
+                }
+            }
+            results.append(id);
+        }
+    }
+    return results;
+}
+
+QStringList TRoomDB::getRoomUserDataKeys()
+{
+    if (!mSearchIndexesAreValid) {
+        buildSearchIndexes();
+    }
+    return mRoomUserDataIndex.keys();
+}
+
+QStringList TRoomDB::getRoomUserDataValues(const QString& key)
+{
+    if (!mSearchIndexesAreValid) {
+        buildSearchIndexes();
+    }
+    return mRoomUserDataIndex.value(key).keys();
+}
+
+QList<int> TRoomDB::getRoomsWithUserData(const QString& key, const QString& value)
+{
+    if (!mSearchIndexesAreValid) {
+        buildSearchIndexes();
+    }
+    const QSet<int> roomIds = mRoomUserDataIndex.value(key).value(value);
+    return QList<int>{roomIds.cbegin(), roomIds.cend()};
 }
 
 void TRoomDB::updateEntranceMap(int id)
@@ -131,46 +312,55 @@ void TRoomDB::updateEntranceMap(TRoom* pR, bool isMapLoading)
 {
     static const bool showDebug = false; // Enable this at runtime (set a breakpoint on it) for debugging!
 
-    // entranceMap maps the room to rooms it has a viable exit to. So if room b and c both have
-    // an exit to room a, upon deleting room a we want a map that allows us to find
-    // room b and c efficiently.
-    // So we create a mapping like: {room_a: room_b, room_a: room_c}. This allows us to delete
-    // rooms and know which other rooms are impacted by this change in a single lookup.
+    // mEntrances maps the room to rooms that have a viable exit to it. So if
+    // room b and c both have an exit to room a, upon deleting room a we want to
+    // find room b and c efficiently - so we have {room_a: {room_b, room_c}}.
+    // mExitTargets holds the opposite direction {room_b: {room_a}, room_c:
+    // {room_a}} so that when the exits of a room change we can remove just
+    // the stale entries rather than having to search for them.
     if (pR) {
         const int id = pR->getId();
         QHash<int, int> const exits = pR->getExits();
-        QList<int> const toExits = exits.keys();
-        QString values;
-        // to update this we need to iterate the entire entranceMap and remove invalid
-        // connections. I'm not sure if this is efficient for every update, and given
-        // that we check for rooms existence when the map is used, we'll deal with
-        // possible spurious exits for now.
-        // entranceMap.remove(id); // <== not what is wanted
-        // We need to remove all values == id NOT keys == id, so try and do that
-        // now. SlySven
-
-        if (!isMapLoading) {
-            deleteValuesFromEntranceMap(id); // When LOADING a map, will never need to do this
+        QSet<int> targets;
+        targets.reserve(exits.size());
+        for (auto itExit = exits.cbegin(); itExit != exits.cend(); ++itExit) {
+            targets.insert(itExit.key());
         }
-        for (const int toExit : toExits) {
-            if (showDebug) {
-                values.append(qsl("%1,").arg(toExit));
-            }
-            if (!entranceMap.contains(toExit, id)) {
-                // entranceMap is a QMultiHash, so multiple, identical entries is
-                // more than possible - it was actually happening and making
-                // entranceMap get larger than needed...!
-                entranceMap.insert(toExit, id);
+
+        if (!isMapLoading) { // When LOADING a map, there will never be anything to remove
+            const QSet<int> previousTargets = mExitTargets.value(id);
+            for (const int previousTarget : previousTargets) {
+                if (targets.contains(previousTarget)) {
+                    continue;
+                }
+                auto itEntrance = mEntrances.find(previousTarget);
+                if (itEntrance != mEntrances.end()) {
+                    itEntrance.value().remove(id);
+                    if (itEntrance.value().isEmpty()) {
+                        mEntrances.erase(itEntrance);
+                    }
+                }
             }
         }
+
+        for (const int target : qAsConst(targets)) {
+            mEntrances[target].insert(id);
+        }
+        if (targets.isEmpty()) {
+            mExitTargets.remove(id);
+        } else {
+            mExitTargets.insert(id, targets);
+        }
+
         if (showDebug) {
-            if (!values.isEmpty()) {
-                values.chop(1);
+            QStringList values;
+            for (const int target : qAsConst(targets)) {
+                values.append(QString::number(target));
             }
             if (values.isEmpty()) {
                 qDebug() << "TRoomDB::updateEntranceMap(TRoom * pR) called for room with id:" << id << ", it is not an Entrance for any Rooms.";
             } else {
-                qDebug() << "TRoomDB::updateEntranceMap(TRoom * pR) called for room with id:" << id << ", it is an Entrance for Room(s):" << values << ".";
+                qDebug() << "TRoomDB::updateEntranceMap(TRoom * pR) called for room with id:" << id << ", it is an Entrance for Room(s):" << values.join(QLatin1Char(',')) << ".";
             }
         }
     }
@@ -179,44 +369,20 @@ void TRoomDB::updateEntranceMap(TRoom* pR, bool isMapLoading)
 // this is call by TRoom destructor only
 bool TRoomDB::__removeRoom(int id)
 {
-    static QMultiHash<int, int> _entranceMap; // Make it persistent - for multiple room deletions
-    static bool isBulkDelete = false;
-    // Gets set / reset by mpTempRoomDeletionSet being non-null, used to setup
-    // _entranceMap the first time around for multi-room deletions
-
     TRoom* pR = getRoom(id);
     // This will FAIL during map deletion as TRoomDB::rooms has already been
     // zapped, so can use to skip everything...
     if (pR) {
-        if (mpTempRoomDeletionSet && mpTempRoomDeletionSet->size() > 1) { // We are deleting multiple rooms
-            if (!isBulkDelete) {
-                _entranceMap = entranceMap;
-                _entranceMap.detach(); // MUST take a deep copy of the data
-                isBulkDelete = true;   // But only do it the first time for a bulk delete
-            }
-        } else {                // We are deleting a single room
-            if (isBulkDelete) { // Last time was a bulk delete but it isn't one now
-                isBulkDelete = false;
-            }
-            _entranceMap.clear();
-            _entranceMap = entranceMap; // Refresh our local copy
-            _entranceMap.detach();      // MUST take a deep copy of the data
-        }
-
         // FIXME: make a proper exit controller so we don't need to do all these if statements
-        // Remove the links from the rooms entering this room
-        QMultiHash<int, int>::const_iterator i = _entranceMap.constFind(id);
-        // The removeAllSpecialExitsToRoom below modifies the entranceMap - and
-        // it is unsafe to modify (use copy operations on) something that an STL
-        // iterator is active on - see "Implicit sharing iterator problem" in
-        // "Container Class | Qt 5.x Core" - this is now avoid by taking a deep
-        // copy and iterating through that instead while modifying the original
-        while (i != _entranceMap.cend() && i.key() == id) {
-            if (i.value() == id || (mpTempRoomDeletionSet && mpTempRoomDeletionSet->size() > 1 && mpTempRoomDeletionSet->contains(i.value()))) {
-                ++i;
+        // Remove the links from the rooms entering this room - the
+        // removeAllSpecialExitsToRoom below modifies mEntrances so work
+        // through a copy of just the (usually small) set for this room:
+        const QSet<int> entrances = mEntrances.value(id);
+        for (const int entranceId : entrances) {
+            if (entranceId == id || (mpTempRoomDeletionSet && mpTempRoomDeletionSet->size() > 1 && mpTempRoomDeletionSet->contains(entranceId))) {
                 continue; // Bypass rooms we know are also to be deleted
             }
-            TRoom* r = getRoom(i.value());
+            TRoom* r = getRoom(entranceId);
             if (r) {
                 if (r->getNorth() == id) {
                     r->setNorth(-1);
@@ -256,9 +422,9 @@ bool TRoomDB::__removeRoom(int id)
                 }
                 r->removeAllSpecialExitsToRoom(id);
             }
-            ++i;
         }
         rooms.remove(id);
+        removeRoomFromSearchIndexes(pR);
         if (roomIDToHash.contains(id)) {
             const QString hash = roomIDToHash[id];
             roomIDToHash.remove(id);
@@ -269,10 +435,11 @@ bool TRoomDB::__removeRoom(int id)
         if (pA) {
             pA->removeRoom(id);
         }
-        if ((!mpTempRoomDeletionSet) || mpTempRoomDeletionSet->size() == 1) { // if NOT deleting multiple rooms
-            entranceMap.remove(id);                                           // Only removes matching keys
-            deleteValuesFromEntranceMap(id);                                  // Needed to remove matching values
-        }
+        // Both of these only touch the entries for the exits to and from this
+        // room so there is no longer any need to defer them during a bulk
+        // deletion:
+        deleteKeysFromEntranceMap(id);
+        deleteValuesFromEntranceMap(id);
         // Because we clear the graph in initGraph which will be called
         // if mMapGraphNeedsUpdate is true -- we don't need to
         // remove the vertex using clear_vertex and remove_vertex here
@@ -307,7 +474,6 @@ void TRoomDB::removeRoom(QSet<int>& ids)
 {
     QElapsedTimer timer;
     timer.start();
-    QSet<int> deletedRoomIds;
     mpTempRoomDeletionSet = &ids; // Will activate "bulk room deletion" code
                                   // When used by TLuaInterpreter::deleteArea()
                                   // via removeArea(int) the list of rooms to
@@ -320,15 +486,10 @@ void TRoomDB::removeRoom(QSet<int>& ids)
         const int deleteRoomId = *(mpTempRoomDeletionSet->constBegin());
         TRoom* pR = getRoom(deleteRoomId);
         if (pR) {
-            deletedRoomIds.insert(deleteRoomId);
             delete pR;
         }
         mpTempRoomDeletionSet->remove(deleteRoomId);
     }
-    for (auto deleteRoomId : deletedRoomIds) {
-        entranceMap.remove(deleteRoomId); // This has been deferred from __removeRoom()
-    }
-    deleteValuesFromEntranceMap(deletedRoomIds);
     mpTempRoomDeletionSet->clear();
     mpTempRoomDeletionSet = nullptr;
     qDebug() << "TRoomDB::removeRoom(QList<int>) run time for" << roomcount << "rooms:" << timer.nsecsElapsed() * 1.0e-9 << "sec.";
@@ -1085,6 +1246,9 @@ void TRoomDB::auditRooms(QHash<int, int>& roomRemapping, QHash<int, int>& areaRe
         }
     }
     // END OF TASK 8
+
+    // Room ids and user data may have been changed above:
+    invalidateSearchIndexes();
 }
 
 void TRoomDB::clearMapDB()
@@ -1093,7 +1257,9 @@ void TRoomDB::clearMapDB()
     timer.start();
     QList<TRoom*> const rPtrL = getRoomPtrList();
     rooms.clear(); // Prevents any further use of TRoomDB::getRoom(int) !!!
-    entranceMap.clear();
+    mEntrances.clear();
+    mExitTargets.clear();
+    invalidateSearchIndexes();
     areaNamesMap.clear();
     hashToRoomID.clear();
     roomIDToHash.clear();
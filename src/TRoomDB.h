@@ -28,7 +28,9 @@
 #include <QApplication>
 #include <QHash>
 #include <QMap>
+#include <QSet>
 #include <QString>
+#include <QStringList>
 #include "post_guard.h"
 
 #include "utils.h"
@@ -75,9 +77,10 @@ public:
     const QMap<int, QString>& getAreaNamesMap() const { return areaNamesMap; }
     void updateEntranceMap(TRoom*, bool isMapLoading = false);
     void updateEntranceMap(int);
-    const QMultiHash<int, int>& getEntranceHash() const { return entranceMap; }
+    QList<int> getEntrances(const int id) const;
     void deleteValuesFromEntranceMap(int);
     void deleteValuesFromEntranceMap(QSet<int>&);
+    void deleteKeysFromEntranceMap(const int);
 
     void buildAreas();
     void clearMapDB();
@@ -90,14 +93,26 @@ public:
     qreal get2DMapZoom(const int areaId) const;
     bool set2DMapZoom(const int areaId, const qreal zoom) const;
 
+    // Indexes used by the searchRoom(...) and searchRoomUserData(...) Lua
+    // functions, they are built on first use and then kept up to date by the
+    // TRoom::setName(...)/setUserData(...) etc. methods - anything that changes
+    // those in bulk (loading, auditing) just invalidates them:
+    void roomNameChanged(TRoom*, const QString& oldName);
+    void roomUserDataChanged(TRoom*, const QString& key, const QString& oldValue);
+    void invalidateSearchIndexes();
+    QList<int> searchRoomsByName(const QString&, const bool caseSensitive, const bool exactMatch);
+    QStringList getRoomUserDataKeys();
+    QStringList getRoomUserDataValues(const QString& key);
+    QList<int> getRoomsWithUserData(const QString& key, const QString& value);
+
     // This is for muds that provide hashes to rooms instead of IDs.
     // If it exists, we delete the info when deleting a room.
     // But we rely on the user to add the data, don't do any checking,
     // and it isn't audited.
-    // It should be a QHash, but changing it would break loading from files
-    // saved under the old version.
-    QMap<QString, int> hashToRoomID;
-    QMap<int, QString> roomIDToHash;
+    // It is stored in the map file as a QMap (which QDataStream serialises
+    // in key order) so it is converted to/from that when saving/loading.
+    QHash<QString, int> hashToRoomID;
+    QHash<int, QString> roomIDToHash;
 
 
 private:
@@ -106,14 +121,29 @@ private:
     int createNewAreaID();
     bool __removeRoom(int id);
     void setAreaRooms(int, const QSet<int>&); // Used by XMLImport to fix rooms data after import
+    void buildSearchIndexes();
+    void addRoomToSearchIndexes(TRoom*);
+    void removeRoomFromSearchIndexes(TRoom*);
 
     QHash<int, TRoom*> rooms;
-    QMultiHash<int, int> entranceMap; // key is exit target, value is exit source
+    // Reverse adjacency for the exits of all rooms, kept in both directions so
+    // that everything about a room can be found/removed in O(degree) time:
+    // key is exit target, value is the exit sources:
+    QHash<int, QSet<int>> mEntrances;
+    // key is exit source, value is the exit targets it was last recorded with:
+    QHash<int, QSet<int>> mExitTargets;
     QMap<int, TArea*> areas;
     QMap<int, QString> areaNamesMap;
     TMap* mpMap;
     QSet<int>* mpTempRoomDeletionSet; // Used during bulk room deletion
 
+    // key is the case folded room name, value is the rooms with that name:
+    QHash<QString, QSet<int>> mRoomNameIndex;
+    // key is the user data key, value is a hash of the values that it has and
+    // the rooms that have each of them:
+    QHash<QString, QHash<QString, QSet<int>>> mRoomUserDataIndex;
+    bool mSearchIndexesAreValid = false;
+
     friend class TRoom;
     friend class XMLexport;
     friend class XMLimport;
@@ -99,6 +99,7 @@ void TScript::callEventHandler(const TEvent& pEvent)
 {
     // Only call this event handler if this script and all its ancestors are active:
     if (isActive() && ancestorsActive()) {
+        const TProfilerSample profilerSample(mpHost->mProfiler, TProfiler::Script, mID, mName, TProfilerSample::Run);
         mpHost->mLuaInterpreter.callEventHandler(mName, pEvent);
     }
 }
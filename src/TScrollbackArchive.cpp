@@ -0,0 +1,251 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by The Mudlet Developers - mudlet.org              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "TScrollbackArchive.h"
+
+#include "pre_guard.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include "post_guard.h"
+
+#include "utils.h"
+
+#include <iterator>
+#include <memory>
+
+TScrollbackArchive::TScrollbackArchive(const QString& directory)
+: mFile(QDir(directory).filePath(qsl("scrollback_XXXXXX.dat")))
+, mBlockCache(csmCachedBlocks)
+{
+    // The archive only lasts as long as the console it belongs to, the file
+    // is removed when this is destroyed:
+    if (!mFile.open()) {
+        qWarning().nospace().noquote() << "TScrollbackArchive::TScrollbackArchive(\"" << directory << "\") WARNING - unable to create archive file, reason: " << mFile.errorString() << ".";
+    }
+}
+
+void TScrollbackArchive::append(Line&& line)
+{
+    if (!mFile.isOpen()) {
+        return;
+    }
+
+    mPendingLines.push_back(std::move(line));
+    if (static_cast<int>(mPendingLines.size()) >= mFlushThreshold) {
+        flushPendingLines();
+    }
+}
+
+// Writes out as many whole blocks as there are pending lines for:
+void TScrollbackArchive::flushPendingLines()
+{
+    int written = 0;
+    while (static_cast<int>(mPendingLines.size()) - written >= csmLinesPerBlock) {
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream << static_cast<quint32>(csmLinesPerBlock);
+        for (int i = written; i < written + csmLinesPerBlock; ++i) {
+            writeLine(stream, mPendingLines.at(i));
+        }
+        const QByteArray compressedData = qCompress(data);
+
+        BlockLocation location;
+        location.mOffset = mFile.size();
+        location.mSize = compressedData.size();
+        if (!mFile.seek(location.mOffset) || mFile.write(compressedData) != compressedData.size() || !mFile.flush()) {
+            qWarning().nospace().noquote() << "TScrollbackArchive::flushPendingLines() WARNING - unable to write to \"" << mFile.fileName() << "\", reason: " << mFile.errorString()
+                                           << ", the lines will be held in memory and writing them will be tried again later.";
+            // Remove anything that did get written so the next block starts
+            // in the right place:
+            mFile.resize(location.mOffset);
+            break;
+        }
+        mBlockIndex.append(location);
+        written += csmLinesPerBlock;
+    }
+
+    mPendingLines.erase(mPendingLines.begin(), mPendingLines.begin() + written);
+    // If something could not be written then do not try again until there is
+    // another block's worth, rather than on every line:
+    mFlushThreshold = static_cast<int>(mPendingLines.size()) + csmLinesPerBlock - static_cast<int>(mPendingLines.size()) % csmLinesPerBlock;
+}
+
+// Each line is stored as its text, time stamp and prompt flag followed by its
+// formatting as runs of identical TChars, of which there are typically only a
+// handful per line:
+void TScrollbackArchive::writeLine(QDataStream& stream, const Line& line)
+{
+    stream << line.mText << line.mTime << line.mIsPrompt;
+    std::vector<std::pair<std::deque<TChar>::const_iterator, quint32>> runs;
+    for (auto it = line.mChars.cbegin(); it != line.mChars.cend();) {
+        auto runEnd = std::next(it);
+        while (runEnd != line.mChars.cend() && runEnd->mFgColor == it->mFgColor && runEnd->mBgColor == it->mBgColor && runEnd->mFlags == it->mFlags
+               && runEnd->mLinkIndex == it->mLinkIndex) {
+            ++runEnd;
+        }
+        runs.emplace_back(it, static_cast<quint32>(std::distance(it, runEnd)));
+        it = runEnd;
+    }
+    stream << static_cast<quint32>(runs.size());
+    for (const auto& [format, length] : runs) {
+        // The search highlighting is not worth keeping:
+        stream << length << format->mFgColor << format->mBgColor << static_cast<quint32>(format->mFlags & ~TChar::Found) << static_cast<qint32>(format->mLinkIndex);
+    }
+}
+
+std::vector<TScrollbackArchive::Line>* TScrollbackArchive::readBlock(int blockNumber) const
+{
+    const BlockLocation& location = mBlockIndex.at(blockNumber);
+    if (!mFile.seek(location.mOffset)) {
+        return nullptr;
+    }
+    const QByteArray data = qUncompress(mFile.read(location.mSize));
+    if (data.isEmpty()) {
+        return nullptr;
+    }
+
+    QDataStream stream(data);
+    quint32 lineCount = 0;
+    stream >> lineCount;
+    auto pBlock = new std::vector<Line>(lineCount);
+    for (auto& line : *pBlock) {
+        quint32 runCount = 0;
+        stream >> line.mText >> line.mTime >> line.mIsPrompt >> runCount;
+        for (quint32 run = 0; run < runCount; ++run) {
+            quint32 length = 0;
+            QColor foreground;
+            QColor background;
+            quint32 flags = 0;
+            qint32 linkIndex = 0;
+            stream >> length >> foreground >> background >> flags >> linkIndex;
+            line.mChars.insert(line.mChars.end(), length, TChar(foreground, background, TChar::AttributeFlags(flags), linkIndex));
+        }
+    }
+    if (stream.status() != QDataStream::Ok) {
+        qWarning().nospace().noquote() << "TScrollbackArchive::readBlock(" << blockNumber << ") WARNING - block in \"" << mFile.fileName() << "\" is corrupt.";
+        delete pBlock;
+        return nullptr;
+    }
+    return pBlock;
+}
+
+const std::vector<TScrollbackArchive::Line>* TScrollbackArchive::block(int blockNumber)
+{
+    if (auto pBlock = mBlockCache.object(blockNumber)) {
+        return pBlock;
+    }
+
+    auto pBlock = readBlock(blockNumber);
+    if (!pBlock) {
+        return nullptr;
+    }
+    // QCache takes ownership, it will delete the least recently used block
+    // when it needs room for this one:
+    mBlockCache.insert(blockNumber, pBlock);
+    return mBlockCache.object(blockNumber);
+}
+
+const TScrollbackArchive::Line* TScrollbackArchive::archivedLine(int lineNumber)
+{
+    if (lineNumber < 0 || lineNumber >= lineCount()) {
+        return nullptr;
+    }
+
+    const int blockNumber = lineNumber / csmLinesPerBlock;
+    if (blockNumber >= mBlockIndex.size()) {
+        return &mPendingLines.at(lineNumber - mBlockIndex.size() * csmLinesPerBlock);
+    }
+
+    const std::vector<Line>* pBlock = block(blockNumber);
+    const std::size_t index = lineNumber % csmLinesPerBlock;
+    return (pBlock && index < pBlock->size()) ? &pBlock->at(index) : nullptr;
+}
+
+QString TScrollbackArchive::line(int lineNumber)
+{
+    const Line* pLine = archivedLine(lineNumber);
+    return pLine ? pLine->mText : QString();
+}
+
+// Both limits are inclusive and are clamped to the lines that are available:
+QStringList TScrollbackArchive::lines(int from, int to)
+{
+    QStringList result;
+    from = qMax(0, from);
+    to = qMin(lineCount() - 1, to);
+    if (from > to) {
+        return result;
+    }
+
+    result.reserve(to - from + 1);
+    for (int lineNumber = from; lineNumber <= to; ++lineNumber) {
+        result.append(line(lineNumber));
+    }
+    return result;
+}
+
+int TScrollbackArchive::findBackwards(const QString& what, const Qt::CaseSensitivity caseSensitivity, int before)
+{
+    if (what.isEmpty()) {
+        return -1;
+    }
+
+    for (int lineNumber = qMin(before, lineCount()) - 1; lineNumber >= 0; --lineNumber) {
+        const Line* pLine = archivedLine(lineNumber);
+        if (pLine && pLine->mText.contains(what, caseSensitivity)) {
+            return lineNumber;
+        }
+    }
+    return -1;
+}
+
+std::vector<TScrollbackArchive::Line> TScrollbackArchive::takeNewestLines(const int minimum)
+{
+    // Gathered newest block first and put into order at the end:
+    std::vector<std::vector<Line>> takenBlocks;
+    int takenCount = static_cast<int>(mPendingLines.size());
+    takenBlocks.push_back(std::move(mPendingLines));
+    mPendingLines.clear();
+    while (takenCount < minimum && !mBlockIndex.isEmpty()) {
+        const int blockNumber = mBlockIndex.size() - 1;
+        std::unique_ptr<std::vector<Line>> pBlock(mBlockCache.take(blockNumber));
+        if (!pBlock) {
+            pBlock.reset(readBlock(blockNumber));
+        }
+        if (!pBlock) {
+            // Leave an unreadable block where it is rather than lose track of
+            // how many lines come before it:
+            break;
+        }
+        takenCount += static_cast<int>(pBlock->size());
+        takenBlocks.push_back(std::move(*pBlock));
+        mFile.resize(mBlockIndex.last().mOffset);
+        mBlockIndex.removeLast();
+    }
+    mFlushThreshold = csmLinesPerBlock;
+
+    std::vector<Line> result;
+    result.reserve(takenCount);
+    for (auto it = takenBlocks.rbegin(); it != takenBlocks.rend(); ++it) {
+        result.insert(result.end(), std::make_move_iterator(it->begin()), std::make_move_iterator(it->end()));
+    }
+    return result;
+}
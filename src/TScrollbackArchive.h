@@ -0,0 +1,103 @@
+#ifndef MUDLET_TSCROLLBACKARCHIVE_H
+#define MUDLET_TSCROLLBACKARCHIVE_H
+
+/***************************************************************************
+ *   Copyright (C) 2026 by The Mudlet Developers - mudlet.org              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "TBuffer.h"
+
+#include "pre_guard.h"
+#include <QCache>
+#include <QDataStream>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryFile>
+#include <QVector>
+#include "post_guard.h"
+
+#include <deque>
+#include <vector>
+
+// A cold store for lines that have been trimmed off the front of a TBuffer.
+// Lines - with their formatting, time stamp and prompt flag - are gathered
+// into fixed size blocks that are compressed and appended to a file, only an
+// index of where each block starts is kept in memory and the most recently
+// read blocks are held in a small LRU cache so that paging through the
+// history does not keep decompressing the same data:
+class TScrollbackArchive
+{
+public:
+    struct Line
+    {
+        std::deque<TChar> mChars;
+        QString mText;
+        qint64 mTime = TBuffer::csmNoTimeStamp;
+        bool mIsPrompt = false;
+    };
+
+    // The file is created in the given directory with a unique name, so that
+    // no two archives can ever share one:
+    explicit TScrollbackArchive(const QString& directory);
+    TScrollbackArchive(const TScrollbackArchive&) = delete;
+    TScrollbackArchive& operator=(const TScrollbackArchive&) = delete;
+
+    bool isValid() const { return mFile.isOpen(); }
+    QString errorString() const { return mFile.errorString(); }
+    QString fileName() const { return mFile.fileName(); }
+    int lineCount() const { return mBlockIndex.size() * csmLinesPerBlock + static_cast<int>(mPendingLines.size()); }
+    void append(Line&&);
+    QStringList lines(int from, int to);
+    QString line(int lineNumber);
+    // Looks back from the line before the given one for the first line that
+    // contains the text, returns -1 if there is none:
+    int findBackwards(const QString& what, const Qt::CaseSensitivity, int before);
+    // Removes at least the given number of the most recently archived lines
+    // (or all of them if there are fewer) and returns them, oldest first:
+    std::vector<Line> takeNewestLines(int minimum);
+
+private:
+    struct BlockLocation
+    {
+        qint64 mOffset = 0;
+        qint32 mSize = 0;
+    };
+
+    static void writeLine(QDataStream&, const Line&);
+    void flushPendingLines();
+    std::vector<Line>* readBlock(int blockNumber) const;
+    const std::vector<Line>* block(int blockNumber);
+    const Line* archivedLine(int lineNumber);
+
+
+    // Large enough to be worth compressing but small enough to decompress
+    // quickly when just a few lines are wanted:
+    static constexpr int csmLinesPerBlock = 256;
+    static constexpr int csmCachedBlocks = 16;
+
+    mutable QTemporaryFile mFile;
+    QVector<BlockLocation> mBlockIndex;
+    // The lines that have not yet made up a whole block - or that could not
+    // be written out; they are kept here rather than lost and writing them is
+    // tried again once another block's worth has built up:
+    std::vector<Line> mPendingLines;
+    int mFlushThreshold = csmLinesPerBlock;
+    QCache<int, std::vector<Line>> mBlockCache;
+};
+
+#endif // MUDLET_TSCROLLBACKARCHIVE_H
@@ -201,6 +201,11 @@ void TTextEdit::slot_toggleTimeStamps(const bool state)
 void TTextEdit::slot_scrollBarMoved(int line)
 {
     if (mpConsole->mpScrollBar) {
+        // Dragging to the top pages lines back in from the scrollback archive
+        // if there is one:
+        if (line <= mScreenHeight && mpConsole->mpScrollbackArchive) {
+            line += mpConsole->restoreArchivedLines(mScreenHeight);
+        }
         updateScrollBar(line);
         scrollTo(line);
     }
@@ -400,9 +405,13 @@ void TTextEdit::scrollTo(int line)
             mpConsole->mLowerPane->show();
             mpConsole->mLowerPane->forceUpdate();
         } else if ((line > (mpBuffer->getLastLineNumber())) && !mIsTailMode) {
+            mIsTailMode = true;
+            if (const int linesTrimmed = mpBuffer->trimToLinesLimit()) {
+                line -= linesTrimmed;
+                updateScrollBar(line);
+            }
             mpConsole->mLowerPane->mCursorY = mpConsole->buffer.getLastLineNumber();
             mpConsole->mLowerPane->hide();
-            mIsTailMode = true;
             mCursorY = mpConsole->buffer.getLastLineNumber();
             updateScreenView();
             forceUpdate();
@@ -483,7 +492,7 @@ void TTextEdit::drawLine(QPainter& painter, int lineNumber, int lineOfScreen, in
     int currentSize = lineText.size();
     if (mShowTimeStamps) {
         TChar timeStampStyle(QColor(200, 150, 0), QColor(22, 22, 22));
-        QString timestamp(mpBuffer->timeBuffer.at(lineNumber));
+        QString timestamp(mpBuffer->timeStampAt(lineNumber));
         QVector<QColor> fgColors;
         QVector<QRect> textRects;
         QVector<int> charWidths;
@@ -1849,11 +1858,9 @@ QString TTextEdit::getSelectedText(const QChar& newlineChar, const bool showTime
     }
 
     if (showTimestamps) {
-        QStringList timestamps = mpBuffer->timeBuffer.mid(startLine, endLine - startLine + 1);
-        QStringList result;
-        std::transform(textLines.cbegin(), textLines.cend(), timestamps.cbegin(), std::back_inserter(result),
-                               [](const QString& text, const QString& timestamp) { return timestamp + text; });
-        textLines = result;
+        for (int i = 0, total = textLines.size(); i < total; ++i) {
+            textLines[i] = mpBuffer->timeStampAt(startLine + i) % textLines.at(i);
+        }
     }
 
     return textLines.join(newlineChar);
@@ -2177,6 +2184,26 @@ int TTextEdit::bufferScrollDown(int lines)
     }
 }
 
+// Lines have been put back at the top of the buffer, so everything here that
+// refers to a line needs to move down by that many to stay with its text:
+void TTextEdit::adjustForRestoredLines(const int count)
+{
+    if (mIsLowerPane) {
+        mCursorY += count;
+    }
+    if (!mPA.isNull() || !mPB.isNull()) {
+        mPA.ry() += count;
+        mPB.ry() += count;
+    }
+    mDragStart.ry() += count;
+    mDragSelectionEnd.ry() += count;
+    mCaretLine += count;
+    if (!mIsLowerPane) {
+        updateScrollBar(mpBuffer->mCursorY);
+    }
+    forceUpdate();
+}
+
 int TTextEdit::getColumnCount()
 {
     int charWidth;
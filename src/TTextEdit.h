@@ -86,6 +86,7 @@ public:
     void focusInEvent(QFocusEvent* event) override;
     int imageTopLine();
     int bufferScrollDown(int lines);
+    void adjustForRestoredLines(const int count);
 // Not used:    void setConsoleFgColor(int r, int g, int b) { mFgColor = QColor(r, g, b); }
     void setConsoleBgColor(int r, int g, int b, int a ) { mBgColor = QColor(r, g, b, a); }
     void resetHScrollbar() { mScreenOffset = 0; mMaxHRange = 0; }
@@ -206,6 +206,8 @@ void TTimer::execute()
         return;
     }
 
+    const TProfilerSample profilerSample(mpHost->mProfiler, TProfiler::Timer, mID, mName, TProfilerSample::Run);
+
     if (isTemporary()) {
         if (mScript.isEmpty()) {
             mpHost->mLuaInterpreter.call_luafunction(this);
@@ -30,6 +30,7 @@
 #include "TDebug.h"
 #include "TMatchState.h"
 #include "TMedia.h"
+#include "TRegexCache.h"
 #include "mudlet.h"
 #include "pre_guard.h"
 #include <QRegularExpression>
@@ -127,10 +128,6 @@ TTrigger::~TTrigger()
         itColorTable.remove();
     }
 
-    for (auto && [key, value] : mConditionMap) {
-        delete value;
-    }
-
     if (!mpHost) {
         return;
     }
@@ -154,11 +151,6 @@ void TTrigger::setName(const QString& name)
     mpHost->getTriggerUnit()->mLookupTable.insert(name, this);
 }
 
-static void pcre_deleter(pcre* pointer)
-{
-    pcre_free(pointer);
-}
-
 //FIXME: lock if code *OR* regex doesn't compile
 bool TTrigger::setRegexCodeList(QStringList patterns, QList<int> patternKinds)
 {
@@ -211,11 +203,9 @@ bool TTrigger::setRegexCodeList(QStringList patterns, QList<int> patternKinds)
             const char* error;
             const QByteArray& regexp = patterns.at(i).toUtf8();
 
-            int erroffset;
-
-            // PCRE_UTF8 needed to run compile in UTF-8 mode
-            // PCRE_UCP needed for \d, \w etc. to use Unicode properties:
-            QSharedPointer<pcre> const re(pcre_compile(regexp.constData(), PCRE_UTF8 | PCRE_UCP, &error, &erroffset, nullptr), pcre_deleter);
+            // Shared with any other trigger or alias, in any profile, that
+            // uses the same pattern:
+            QSharedPointer<pcre> const re = TRegexCache::compile(regexp, &error);
 
             if (!re) {
                 if (mudlet::smDebugMode) {
@@ -577,35 +567,36 @@ inline void TTrigger::updateMultistates(int regexNumber, std::list<std::string>&
 {
     if (regexNumber == 0) {
         // automatically set to #1
-        auto pCondition = new TMatchState(mPatterns.size(), mConditionLineDelta);
-        mConditionMap[pCondition] = pCondition;
-        pCondition->multiCaptureList.push_back(captureList);
-        pCondition->multiCapturePosList.push_back(posList);
+        auto [pCondition, isOldestDropped] = mMatchStates.acquire(mPatterns.size(), mConditionLineDelta);
+        if (isOldestDropped && mudlet::smDebugMode) {
+            TDebug(Qt::darkYellow, Qt::black) << "Trigger name=" << mName << " has reached the limit of " << TMatchStatePool::csmMaxActiveStates
+                                              << " partial matches, dropping the oldest one.\n"
+                    >> mpHost;
+        }
+        pCondition->addCaptures(captureList, posList);
         if (nameMatches) {
             pCondition->nameCaptures.push_back(*nameMatches);
         } else {
             pCondition->nameCaptures.push_back(QVector<QPair<QString, QString>>());
         }
         if (mudlet::smDebugMode) {
-            TDebug(Qt::darkYellow, Qt::black) << "match state " << mConditionMap.size() << "/" << mConditionMap.size() << " condition #" << regexNumber << "=true (" << regexNumber
+            TDebug(Qt::darkYellow, Qt::black) << "match state " << mMatchStates.size() << "/" << mMatchStates.size() << " condition #" << regexNumber << "=true (" << regexNumber
                                               << "/" << mPatterns.size() << ") regex=" << mPatterns[regexNumber] << "\n"
                     >> mpHost;
         }
     } else {
-        int k = 0;
-        for (auto& matchStatePair : mConditionMap) {
-            k++;
-            if (matchStatePair.second->nextCondition() == regexNumber) {
+        for (size_t i = 0; i < mMatchStates.size(); ++i) {
+            TMatchState* pState = mMatchStates.at(i);
+            if (pState->nextCondition() == regexNumber) {
                 if (mudlet::smDebugMode) {
-                    TDebug(Qt::darkYellow, Qt::black) << "match state " << k << "/" << mConditionMap.size() << " condition #" << regexNumber << "=true (" << regexNumber << "/"
+                    TDebug(Qt::darkYellow, Qt::black) << "match state " << i + 1 << "/" << mMatchStates.size() << " condition #" << regexNumber << "=true (" << regexNumber << "/"
                                                       << mPatterns.size() << ") regex=" << mPatterns[regexNumber] << "\n"
                             >> mpHost;
                 }
-                matchStatePair.second->conditionMatched();
-                matchStatePair.second->multiCaptureList.push_back(captureList);
-                matchStatePair.second->multiCapturePosList.push_back(posList);
+                pState->conditionMatched();
+                pState->addCaptures(captureList, posList);
                 if (nameMatches != nullptr) {
-                    matchStatePair.second->nameCaptures.push_back(*nameMatches);
+                    pState->nameCaptures.push_back(*nameMatches);
                 }
             }
         }
@@ -837,23 +828,18 @@ void TTrigger::processColorPattern(int patternNumber, std::list<std::string>& ca
 bool TTrigger::match_line_spacer(int patternNumber)
 {
     if (mIsMultiline) {
-        int k = 0;
-
-        for (auto& matchStatePair : mConditionMap) {
-            k++;
-            if (matchStatePair.second->nextCondition() == patternNumber) {
-                if (matchStatePair.second->lineSpacerMatch(mPatterns.value(patternNumber).toInt())) {
+        for (size_t i = 0; i < mMatchStates.size(); ++i) {
+            TMatchState* pState = mMatchStates.at(i);
+            if (pState->nextCondition() == patternNumber) {
+                if (pState->lineSpacerMatch(mPatterns.value(patternNumber).toInt())) {
                     if (mudlet::smDebugMode) {
                         TDebug(Qt::yellow, Qt::black) << "Trigger name=" << mName << "(" << mPatterns.value(patternNumber) << ") condition #" << patternNumber << "=true " >> mpHost;
-                        TDebug(Qt::darkYellow, Qt::black) << TDebug::csmContinue << "match state " << k << "/" << mConditionMap.size() << " condition #" << patternNumber << "=true (" << patternNumber + 1 << "/"
+                        TDebug(Qt::darkYellow, Qt::black) << TDebug::csmContinue << "match state " << i + 1 << "/" << mMatchStates.size() << " condition #" << patternNumber << "=true (" << patternNumber + 1 << "/"
                                                           << mPatterns.size() << ") line spacer=" << mPatterns.value(patternNumber) << "lines\n"
                                                           >> mpHost;
                     }
-                    matchStatePair.second->conditionMatched();
-                    std::list<std::string> const captureList;
-                    std::list<int> const posList;
-                    matchStatePair.second->multiCaptureList.push_back(captureList);
-                    matchStatePair.second->multiCapturePosList.push_back(posList);
+                    pState->conditionMatched();
+                    pState->addCaptures(std::list<std::string>(), std::list<int>());
                 }
             }
         }
@@ -981,6 +967,7 @@ bool TTrigger::match(char* haystackC, const QString& haystack, int line, int pos
 {
     bool ret = false;
     if (isActive()) {
+        const TProfilerSample profilerSample(mpHost->mProfiler, TProfiler::Trigger, mID, mName, TProfilerSample::Match);
         if (mIsLineTrigger) {
             if (--mStartOfLineDelta < 0) {
                 execute();
@@ -1001,9 +988,10 @@ bool TTrigger::match(char* haystackC, const QString& haystack, int line, int pos
 
         int highestCondition = 0;
         if (mIsMultiline) {
-            for (auto& matchStatePair : mConditionMap) {
-                matchStatePair.second->newLineArrived();
-                const int next = matchStatePair.second->nextCondition();
+            for (size_t i = 0; i < mMatchStates.size(); ++i) {
+                TMatchState* pState = mMatchStates.at(i);
+                pState->newLineArrived();
+                const int next = pState->nextCondition();
                 if (next > highestCondition) {
                     highestCondition = next;
                 }
@@ -1068,24 +1056,25 @@ bool TTrigger::match(char* haystackC, const QString& haystack, int line, int pos
         if (mIsMultiline) {
             int k = 0;
             conditionMet = false; //invalidate conditionMet as it has no meaning for multiline triggers
-            std::list<TMatchState*> removeList;
+            bool isReclaimNeeded = false;
 
-            for (auto& matchStatePair : mConditionMap) {
+            for (size_t i = 0; i < mMatchStates.size(); ++i) {
+                TMatchState* pState = mMatchStates.at(i);
                 k++;
-                if (matchStatePair.second->isComplete()) {
+                if (pState->isComplete()) {
                     mKeepFiring = mStayOpen;
                     if (mudlet::smDebugMode) {
                         TDebug(Qt::yellow, Qt::darkMagenta) << "multiline trigger name=" << mName << " *FIRES* all conditions are fulfilled. Executing script.\n" >> mpHost;
                     }
-                    removeList.push_back(matchStatePair.first);
+                    pState->mIsToBeReclaimed = true;
+                    isReclaimNeeded = true;
                     conditionMet = true;
+                    const std::list<std::list<std::string>> multiCaptureList = pState->multiCaptureList();
                     TLuaInterpreter* pL = mpHost->getLuaInterpreter();
-                    pL->setMultiCaptureGroups(matchStatePair.second->multiCaptureList, matchStatePair.second->multiCapturePosList, matchStatePair.second->nameCaptures);
+                    pL->setMultiCaptureGroups(multiCaptureList, pState->multiCapturePosList(), pState->nameCaptures);
                     execute();
                     pL->clearCaptureGroups();
                     if (mFilterTrigger) {
-                        std::list<std::list<std::string>> multiCaptureList;
-                        multiCaptureList = matchStatePair.second->multiCaptureList;
                         if (!multiCaptureList.empty()) {
                             for (auto mit = multiCaptureList.begin(); mit != multiCaptureList.end(); mit++, k++) {
                                 const int total = (*mit).size();
@@ -1106,18 +1095,16 @@ bool TTrigger::match(char* haystackC, const QString& haystack, int line, int pos
                     }
                 }
 
-                if (!matchStatePair.second->newLine()) {
-                    removeList.push_back(matchStatePair.first);
+                if (!pState->newLine()) {
+                    pState->mIsToBeReclaimed = true;
+                    isReclaimNeeded = true;
                 }
             }
-            for (auto& matchState : removeList) {
-                if (mConditionMap.find(matchState) != mConditionMap.end()) {
-                    delete mConditionMap[matchState];
-                    if (mudlet::smDebugMode) {
-                        TDebug(Qt::darkBlue, Qt::black) << "removing condition from condition table.\n" >> mpHost;
-                    }
-                    mConditionMap.erase(matchState);
+            if (isReclaimNeeded) {
+                if (mudlet::smDebugMode) {
+                    TDebug(Qt::darkBlue, Qt::black) << "removing completed/expired conditions from condition table.\n" >> mpHost;
                 }
+                mMatchStates.reclaim();
             }
         }
 
@@ -1339,6 +1326,7 @@ bool TTrigger::compileScript()
 
 void TTrigger::execute()
 {
+    const TProfilerSample profilerSample(mpHost->mProfiler, TProfiler::Trigger, mID, mName, TProfilerSample::Run);
     if (mSoundTrigger) { /* eventually something should be added to the gui to change sound volumes. 100=full volume */
         QString mediaFileName = mSoundFile;
 
@@ -23,6 +23,7 @@
  ***************************************************************************/
 
 
+#include "TMatchState.h"
 #include "Tree.h"
 
 #include "pre_guard.h"
@@ -41,7 +42,6 @@
 
 class Host;
 class TLuaInterpreter;
-class TMatchState;
 
 
 #define REGEX_SUBSTRING 0
@@ -54,8 +54,6 @@ class TMatchState;
 #define REGEX_PROMPT 7
 #define MAX_CAPTURE_GROUPS 33
 
-using NameGroupMatches = QVector<QPair<QString, QString>>;
-
 struct TColorTable
 {
     int ansiFg;
@@ -167,6 +165,8 @@ public:
 
     int getExpiryCount() const;
     void setExpiryCount(int expiryCount);
+    // Number of partial matches a multi-line trigger is currently tracking:
+    int getActiveMatchStateCount() const { return static_cast<int>(mMatchStates.size()); }
 
 
 private:
@@ -198,7 +198,7 @@ private:
     bool mIsMultiline;
     int mConditionLineDelta;
     QString mCommand;
-    std::map<TMatchState*, TMatchState*> mConditionMap;
+    TMatchStatePool mMatchStates;
     std::list<std::list<std::string>> mMultiCaptureGroupList;
     std::list<std::list<int>> mMultiCaptureGroupPosList;
     TLuaInterpreter* mpLua;
@@ -0,0 +1,122 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by The Mudlet Developers - mudlet.org              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+
+#include "TXmlSanitizer.h"
+
+#include <cctype>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+const std::unordered_map<std::string, std::string> qxmlReplacements{
+    {"&#1;", "\uFFFC\u2401"},   // SOH
+    {"&#01;", "\uFFFC\u2401"},   // SOH
+    {"&#2;", "\uFFFC\u2402"},   // STX
+    {"&#02;", "\uFFFC\u2402"},   // STX
+    {"&#3;", "\uFFFC\u2403"},   // ETX
+    {"&#03;", "\uFFFC\u2403"},   // ETX
+    {"&#4;", "\uFFFC\u2404"},   // EOT
+    {"&#04;", "\uFFFC\u2404"},   // EOT
+    {"&#5;", "\uFFFC\u2405"},   // ENQ
+    {"&#05;", "\uFFFC\u2405"},   // ENQ
+    {"&#6;", "\uFFFC\u2406"},   // ACK
+    {"&#06;", "\uFFFC\u2406"},   // ACK
+    {"&#7;", "\uFFFC\u2407"},   // BEL
+    {"&#07;", "\uFFFC\u2407"},   // BEL
+    {"&#8;", "\uFFFC\u2408"},   // BS
+    {"&#08;", "\uFFFC\u2408"},   // BS
+    {"&#11;", "\uFFFC\u240B"},  // VT
+    {"&#12;", "\uFFFC\u240C"},  // FF
+    {"&#14;", "\uFFFC\u240E"},  // SS
+    {"&#15;", "\uFFFC\u240F"},  // SI
+    {"&#10;", "\uFFFC\u2410"},  // DLE
+    {"&#16;", "\uFFFC\u2411"},  // DC1
+    {"&#18;", "\uFFFC\u2412"},  // DC2
+    {"&#19;", "\uFFFC\u2413"},  // DC3
+    {"&#20;", "\uFFFC\u2414"},  // DC4
+    {"&#21;", "\uFFFC\u2415"},  // NAK
+    {"&#22;", "\uFFFC\u2416"},  // SYN
+    {"&#17;", "\uFFFC\u2417"},  // ETB
+    {"&#23;", "\uFFFC\u2418"},  // CAN
+    {"&#25;", "\uFFFC\u2419"},  // EM
+    {"&#26;", "\uFFFC\u241A"},  // SUB
+    {"&#27;", "\uFFFC\u241B"},  // ESC
+    {"&#28;", "\uFFFC\u241C"},  // FS
+    {"&#29;", "\uFFFC\u241D"},  // GS
+    {"&#30;", "\uFFFC\u241E"},  // RS
+    {"&#31;", "\uFFFC\u241F"},  // US
+    {"&#127;", "\uFFFC\u2421"}, // DEL
+};
+// The length of the longest key above:
+const size_t maxQxmlReplacementLength = 6;
+} // namespace
+
+void TXmlSanitizer::append(const char* data, const size_t size)
+{
+    mPending.append(data, size);
+    // Hold back anything from an '&' close to the end of what we have as it
+    // could be the start of a reference that is split across chunks:
+    size_t safeLength = mPending.size();
+    const size_t ampersandPosition = mPending.find('&', (safeLength > maxQxmlReplacementLength) ? (safeLength - maxQxmlReplacementLength) : 0);
+    if (ampersandPosition != std::string::npos) {
+        safeLength = ampersandPosition;
+    }
+    appendSanitized(mOutput, mPending.data(), safeLength);
+    mPending.erase(0, safeLength);
+}
+
+void TXmlSanitizer::flush()
+{
+    appendSanitized(mOutput, mPending.data(), mPending.size());
+    mPending.clear();
+}
+
+// Copies the data to the end of output, making the replacements in a single
+// pass over it rather than searching the whole of it for each one:
+void TXmlSanitizer::appendSanitized(std::string& output, const char* data, const size_t size)
+{
+    size_t position = 0;
+    while (position < size) {
+        const auto pAmpersand = static_cast<const char*>(std::memchr(data + position, '&', size - position));
+        if (!pAmpersand) {
+            output.append(data + position, size - position);
+            return;
+        }
+
+        const size_t ampersandPosition = pAmpersand - data;
+        output.append(data + position, ampersandPosition - position);
+        position = ampersandPosition + 1;
+        if (position < size && data[position] == '#') {
+            size_t end = position + 1;
+            while (end < size && end - ampersandPosition < maxQxmlReplacementLength && std::isdigit(static_cast<unsigned char>(data[end]))) {
+                ++end;
+            }
+            if (end < size && data[end] == ';') {
+                const auto itReplacement = qxmlReplacements.find(std::string(pAmpersand, end + 1 - ampersandPosition));
+                if (itReplacement != qxmlReplacements.cend()) {
+                    output.append(itReplacement->second);
+                    position = end + 1;
+                    continue;
+                }
+            }
+        }
+        output.push_back('&');
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef MUDLET_TXMLSANITIZER_H
+#define MUDLET_TXMLSANITIZER_H
+
+/***************************************************************************
+ *   Copyright (C) 2026 by The Mudlet Developers - mudlet.org              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <cstddef>
+#include <string>
+
+// Replaces the numeric character references that pugixml writes for ASCII
+// control characters with symbols that the qxml based reader in older
+// versions of Mudlet can cope with, as it is stuck at XML 1.0 and does not
+// handle them properly. See https://github.com/Mudlet/Mudlet/issues/500
+//
+// The text can be given in any number of chunks, a reference that is split
+// across two of them is still found - so flush() must be called after the
+// last one:
+class TXmlSanitizer
+{
+public:
+    explicit TXmlSanitizer(std::string& output)
+    : mOutput(output)
+    {}
+
+    void append(const char* data, const size_t size);
+    void flush();
+
+private:
+    static void appendSanitized(std::string& output, const char* data, const size_t size);
+
+
+    std::string& mOutput;
+    // The end of the text given so far that could be the start of a reference
+    // that has not been completed yet:
+    std::string mPending;
+};
+
+#endif // MUDLET_TXMLSANITIZER_H
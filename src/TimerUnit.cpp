@@ -169,7 +169,9 @@ void TimerUnit::_removeTimerRootNode(TTimer* pT)
         mLookupTable.remove(pT->getName());
     }
     mTimerMap.remove(pT->getID());
-    mTimerRootNodeList.remove(pT);
+    if (!mSweepSet.contains(pT)) {
+        mTimerRootNodeList.remove(pT);
+    }
 }
 
 TTimer* TimerUnit::getTimer(int id)
@@ -386,14 +388,18 @@ int TimerUnit::getNewID()
 
 void TimerUnit::doCleanup()
 {
-    QMutableSetIterator<TTimer*> itTimer(mCleanupSet);
-    while (itTimer.hasNext()) {
-        auto pTimer = itTimer.next();
-        // It is important to take the item OUT of the set before you delete
-        // (and thus invalidate this pointer to) it...!
-        itTimer.remove();
+    if (mCleanupSet.isEmpty()) {
+        return;
+    }
+
+    // Take all the doomed root items out of the list in one pass rather than
+    // have each destructor walk the whole list to find itself:
+    mSweepSet.swap(mCleanupSet);
+    mTimerRootNodeList.remove_if([this](TTimer* pT) { return mSweepSet.contains(pT); });
+    for (auto pTimer : qAsConst(mSweepSet)) {
         delete pTimer;
     }
+    mSweepSet.clear();
 }
 
 void TimerUnit::markCleanup(TTimer* pT)
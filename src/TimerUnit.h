@@ -101,6 +101,9 @@ private:
     int mMaxID = 0;
     bool mModuleMember = false;
     QSet<TTimer*> mCleanupSet;
+    // The items being deleted by doCleanup(), already taken out of
+    // mTimerRootNodeList in a single pass:
+    QSet<TTimer*> mSweepSet;
     int statsActiveItems = 0;
     int statsItemsTotal = 0;
     int statsTempItems = 0;
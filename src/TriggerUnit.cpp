@@ -34,6 +34,7 @@ void TriggerUnit::resetStats()
     statsActiveItems = 0;
     statsPatternsTotal = 0;
     statsPatternsActive = 0;
+    statsPartialMatches = 0;
 }
 
 void TriggerUnit::_uninstall(TTrigger* pChild, const QString& packageName)
@@ -130,7 +131,9 @@ void TriggerUnit::removeTriggerRootNode(TTrigger* pT)
         mLookupTable.remove(pT->getName());
     }
     mTriggerMap.remove(pT->getID());
-    mTriggerRootNodeList.remove(pT);
+    if (!mSweepSet.contains(pT)) {
+        mTriggerRootNodeList.remove(pT);
+    }
 }
 
 TTrigger* TriggerUnit::getTrigger(int id)
@@ -249,10 +252,7 @@ void TriggerUnit::processDataStream(const QString& data, int line)
     }
     free(subject);
 
-    for (auto& trigger : mCleanupList) {
-        delete trigger;
-    }
-    mCleanupList.clear();
+    doCleanup();
 }
 
 void TriggerUnit::compileAll()
@@ -373,11 +373,12 @@ void TriggerUnit::assembleReport(TTrigger* pItem)
             ++statsTempItems;
         }
         statsPatternsTotal += pChild->mPatterns.size();
+        statsPartialMatches += pChild->getActiveMatchStateCount();
         assembleReport(pChild);
     }
 }
 
-std::tuple<QString, int, int, int, int, int> TriggerUnit::assembleReport()
+std::tuple<QString, int, int, int, int, int, int> TriggerUnit::assembleReport()
 {
     resetStats();
     for (auto pItem : mTriggerRootNodeList) {
@@ -390,6 +391,7 @@ std::tuple<QString, int, int, int, int, int> TriggerUnit::assembleReport()
             ++statsTempItems;
         }
         statsPatternsTotal += pItem->mPatterns.size();
+        statsPartialMatches += pItem->getActiveMatchStateCount();
         assembleReport(pItem);
     }
     QStringList msg;
@@ -397,31 +399,36 @@ std::tuple<QString, int, int, int, int, int> TriggerUnit::assembleReport()
         << QLatin1String("tempTriggers current total: ") << QString::number(statsTempItems) << QLatin1String("\n")
         << QLatin1String("active triggers: ") << QString::number(statsActiveItems) << QLatin1String("\n")
         << QLatin1String("trigger patterns total: ") << QString::number(statsPatternsTotal) << QLatin1String("\n")
-        << QLatin1String("active patterns total: ") << QString::number(statsPatternsActive) << QLatin1String("\n");
+        << QLatin1String("active patterns total: ") << QString::number(statsPatternsActive) << QLatin1String("\n")
+        << QLatin1String("multiline partial matches pending: ") << QString::number(statsPartialMatches) << QLatin1String("\n");
     return {
         msg.join(QString()),
         statsItemsTotal,
         statsPatternsTotal,
         statsTempItems,
         statsActiveItems,
-        statsPatternsActive
+        statsPatternsActive,
+        statsPartialMatches
     };
 }
 
 void TriggerUnit::doCleanup()
 {
-    for (auto trigger : mCleanupList) {
+    if (mCleanupSet.isEmpty()) {
+        return;
+    }
+
+    // Take all the doomed root items out of the list in one pass rather than
+    // have each destructor walk the whole list to find itself:
+    mSweepSet.swap(mCleanupSet);
+    mTriggerRootNodeList.remove_if([this](TTrigger* pT) { return mSweepSet.contains(pT); });
+    for (auto trigger : qAsConst(mSweepSet)) {
         delete trigger;
     }
-    mCleanupList.clear();
+    mSweepSet.clear();
 }
 
 void TriggerUnit::markCleanup(TTrigger* pT)
 {
-    for (auto trigger : mCleanupList) {
-        if (trigger == pT) {
-            return;
-        }
-    }
-    mCleanupList.push_back(pT);
+    mCleanupSet.insert(pT);
 }
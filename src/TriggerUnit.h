@@ -26,6 +26,7 @@
 #include "pre_guard.h"
 #include <QMultiMap>
 #include <QPointer>
+#include <QSet>
 #include <QString>
 #include "post_guard.h"
 
@@ -69,8 +70,7 @@ public:
     void setTriggerStayOpen(const QString&, int);
     void stopAllTriggers();
     void reenableAllTriggers();
-    std::tuple<QString, int, int, int, int, int> assembleReport();
-    std::list<TTrigger*> mCleanupList;
+    std::tuple<QString, int, int, int, int, int, int> assembleReport();
     int getNewID();
     QMultiMap<QString, TTrigger*> mLookupTable;
     void markCleanup(TTrigger* pT);
@@ -94,11 +94,16 @@ private:
     std::list<TTrigger*> mTriggerRootNodeList;
     int mMaxID;
     bool mModuleMember;
+    QSet<TTrigger*> mCleanupSet;
+    // The items being deleted by doCleanup(), already taken out of
+    // mTriggerRootNodeList in a single pass:
+    QSet<TTrigger*> mSweepSet;
     int statsItemsTotal = 0;
     int statsTempItems = 0;
     int statsActiveItems = 0;
     int statsPatternsTotal = 0;
     int statsPatternsActive = 0;
+    int statsPartialMatches = 0;
 };
 
 #endif // MUDLET_TRIGGERUNIT_H
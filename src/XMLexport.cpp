@@ -33,15 +33,17 @@
 #include "TScript.h"
 #include "TTimer.h"
 #include "TTrigger.h"
+#include "TXmlSanitizer.h"
 #include "VarUnit.h"
 #include "mudlet.h"
 
 #include "pre_guard.h"
 #include <QtConcurrent>
 #include <QFile>
-#include <sstream>
+#include <QFileInfo>
 #include "post_guard.h"
 
+
 XMLexport::XMLexport( Host * pH )
 : mpHost(pH)
 , mpTrigger(nullptr)
@@ -119,7 +121,9 @@ XMLexport::XMLexport( TKey * pT )
 {
 }
 
-void XMLexport::writeModuleXML(const QString& moduleName, const QString& fileName, bool async)
+// Returns false if the module's file did not need to be rewritten because
+// nothing in it has changed - which can only be known when async is false:
+bool XMLexport::writeModuleXML(const QString& moduleName, const QString& fileName, bool async)
 {
     auto pHost = mpHost;
     auto mudletPackage = writeXmlHeader();
@@ -199,15 +203,18 @@ void XMLexport::writeModuleXML(const QString& moduleName, const QString& fileNam
         saveFutures.append(future);
     } else {
         saveXml(fileName);
+        const bool fileWasWritten = !mSaveWasUnchanged;
         mpHost->xmlSaved(fileName);
+        return fileWasWritten;
     }
+    return true;
 }
 
-void XMLexport::exportHost(const QString& filename_pugi_xml)
+void XMLexport::exportHost(const QString& filename_pugi_xml, const QString& previousFileName)
 {
     auto mudletPackage = writeXmlHeader();
     writeHost(mpHost, mudletPackage);
-    auto future = QtConcurrent::run([&, filename_pugi_xml]() { return saveXml(filename_pugi_xml); });
+    auto future = QtConcurrent::run([&, filename_pugi_xml, previousFileName]() { return saveXml(filename_pugi_xml, previousFileName); });
 
     auto watcher = new QFutureWatcher<bool>;
     connect(watcher, &QFutureWatcher<bool>::finished, mpHost, [=]() { mpHost->xmlSaved(qsl("profile")); });
@@ -215,110 +222,80 @@ void XMLexport::exportHost(const QString& filename_pugi_xml)
     saveFutures.append(future);
 }
 
-// credit: https://stackoverflow.com/a/29752943/72944
-void inline XMLexport::replaceAll(std::string& source, const std::string& from, const std::string& to)
+namespace {
+// Receives the text from pugixml in chunks and sanitizes each one as it
+// arrives, so that the document is only held once, as the final output:
+class SanitizingXmlWriter : public pugi::xml_writer
 {
-    std::string newString;
-    newString.reserve(source.length()); // avoids a few memory allocations
+public:
+    explicit SanitizingXmlWriter(std::string& output)
+    : mSanitizer(output)
+    {}
 
-    std::string::size_type lastPos = 0;
-    std::string::size_type findPos;
-
-    while (std::string::npos != (findPos = source.find(from, lastPos))) {
-        newString.append(source, lastPos, findPos - lastPos);
-        newString += to;
-        lastPos = findPos + from.length();
-    }
+    void write(const void* data, size_t size) override { mSanitizer.append(static_cast<const char*>(data), size); }
+    void flush() { mSanitizer.flush(); }
 
-    // Care for the rest after last occurrence
-    newString += source.substr(lastPos);
+private:
+    TXmlSanitizer mSanitizer;
+};
+} // namespace
 
-    source.swap(newString);
+// Produces the final text of the document:
+std::string XMLexport::renderXml()
+{
+    std::string output;
+    SanitizingXmlWriter writer(output);
+    mExportDoc.save(writer);
+    writer.flush();
+    return output;
 }
 
-// sanitize non-printable characters for backwards & forward compatibility
-// work qxml which is stuck at 1.0 and doesn't support properly
-// encoding them. See https://github.com/Mudlet/Mudlet/issues/500
-void XMLexport::sanitizeForQxml(std::string& output)
+// True if the file already holds exactly this text - it is only read when its
+// size matches, which is rarely the case for a file that has been edited:
+bool XMLexport::fileHoldsText(const QString& fileName, const std::string& text)
 {
-    QMap<std::string, std::string> replacements{
-            {"&#1;", "\uFFFC\u2401"},   // SOH
-            {"&#01;", "\uFFFC\u2401"},   // SOH
-            {"&#2;", "\uFFFC\u2402"},   // STX
-            {"&#02;", "\uFFFC\u2402"},   // STX
-            {"&#3;", "\uFFFC\u2403"},   // ETX
-            {"&#03;", "\uFFFC\u2403"},   // ETX
-            {"&#4;", "\uFFFC\u2404"},   // EOT
-            {"&#04;", "\uFFFC\u2404"},   // EOT
-            {"&#5;", "\uFFFC\u2405"},   // ENQ
-            {"&#05;", "\uFFFC\u2405"},   // ENQ
-            {"&#6;", "\uFFFC\u2406"},   // ACK
-            {"&#06;", "\uFFFC\u2406"},   // ACK
-            {"&#7;", "\uFFFC\u2407"},   // BEL
-            {"&#07;", "\uFFFC\u2407"},   // BEL
-            {"&#8;", "\uFFFC\u2408"},   // BS
-            {"&#08;", "\uFFFC\u2408"},   // BS
-            {"&#11;", "\uFFFC\u240B"},  // VT
-            {"&#12;", "\uFFFC\u240C"},  // FF
-            {"&#14;", "\uFFFC\u240E"},  // SS
-            {"&#15;", "\uFFFC\u240F"},  // SI
-            {"&#10;", "\uFFFC\u2410"},  // DLE
-            {"&#16;", "\uFFFC\u2411"},  // DC1
-            {"&#18;", "\uFFFC\u2412"},  // DC2
-            {"&#19;", "\uFFFC\u2413"},  // DC3
-            {"&#20;", "\uFFFC\u2414"},  // DC4
-            {"&#21;", "\uFFFC\u2415"},  // NAK
-            {"&#22;", "\uFFFC\u2416"},  // SYN
-            {"&#17;", "\uFFFC\u2417"},  // ETB
-            {"&#23;", "\uFFFC\u2418"},  // CAN
-            {"&#25;", "\uFFFC\u2419"},  // EM
-            {"&#26;", "\uFFFC\u241A"},  // SUB
-            {"&#27;", "\uFFFC\u241B"},  // ESC
-            {"&#28;", "\uFFFC\u241C"},  // FS
-            {"&#29;", "\uFFFC\u241D"},  // GS
-            {"&#30;", "\uFFFC\u241E"},  // RS
-            {"&#31;", "\uFFFC\u241F"},  // US
-            {"&#127;", "\uFFFC\u2421"}, // DEL
-    };
-
-    // Look for each replacement in data and if not present remove it from the
-    // list of things to replace
-    QMutableMapIterator<std::string, std::string> itReplacement(replacements);
-    while (itReplacement.hasNext()) {
-        itReplacement.next();
-        if (output.find(itReplacement.key()) == std::string::npos) {
-            itReplacement.remove();
-        }
+    QFile file(fileName);
+    if (file.size() != static_cast<qint64>(text.size()) || !file.open(QIODevice::ReadOnly)) {
+        return false;
     }
 
-    if (!replacements.isEmpty()) {
-        // There is at least one thing left in the QMap of replacements and we
-        // can use the same iterator if we reset it to the start of the
-        // remaining replacements:
-        itReplacement.toFront();
-        while (itReplacement.hasNext()) {
-            itReplacement.next();
-            replaceAll(output, itReplacement.key(), itReplacement.value());
-        }
-    }
+    return file.readAll() == QByteArray::fromRawData(text.data(), static_cast<int>(text.size()));
 }
 
-bool XMLexport::saveXml(const QString& fileName)
+// If previousFileName is given and fileName does not exist yet, then when the
+// previous file already holds exactly what would be written it is renamed to
+// fileName instead:
+bool XMLexport::saveXml(const QString& fileName, const QString& previousFileName)
 {
-    QSaveFile file(fileName);
-
     auto printErrorMessage = [&](const QString& errorString) {
         qDebug().noquote().nospace() << "XMLexport::saveXml(\"" << fileName << "\") ERROR - failed to save package, reason: " << errorString << ".";
     };
 
+    const std::string output = renderXml();
+    // Leave the file alone if nothing in it would change - this saves a lot
+    // of writing for autosaves and for modules that have not been edited:
+    mSaveWasUnchanged = fileHoldsText(fileName, output);
+    if (mSaveWasUnchanged) {
+        return true;
+    }
+
+    // Profile saves go to a new, time-stamped, file each time so compare with
+    // the last one of those:
+    if (!previousFileName.isEmpty() && !QFileInfo::exists(fileName) && fileHoldsText(previousFileName, output) && QFile::rename(previousFileName, fileName)) {
+        mSaveWasUnchanged = true;
+        return true;
+    }
+
+    QSaveFile file(fileName);
     if (!file.open(QIODevice::WriteOnly)) {
         printErrorMessage(file.errorString().prepend("failed to open file, "));
         return false;
     }
 
-    bool success = saveXmlFile(file);
+    file.write(output.data(), static_cast<qint64>(output.size()));
+    bool success = (file.error() == QFileDevice::NoError);
     if (!success) {
-        printErrorMessage((file.error() != QFileDevice::NoError) ? file.errorString() : "XML document preparation failure");
+        printErrorMessage(file.errorString());
     } else if (!file.commit()) {
         printErrorMessage(file.errorString());
         success = false;
@@ -330,36 +307,20 @@ bool XMLexport::saveXml(const QString& fileName)
 // TODO: Refactor dlgTriggerEditor::slot_export() {at least} to call this method instead of saveXml(const QString&)
 bool XMLexport::saveXmlFile(QSaveFile& file)
 {
-    std::stringstream saveStringStream(std::ios::out);
-    // Remember, the mExportDoc is the data in the form of a pugi::xml_document
-    // instance - the save method needs a stream that implements the
-    // std::ostream interface into which it can push the data:
-    mExportDoc.save(saveStringStream);
     // We need to do our own replacement of ASCII control characters that are
     // not valid in XML version 1.0 and that means we cannot use the pugixml
     // file methods as it does that in a different way which is not helpful
-    // as we do not use that library for READING the XML files - so convert
-    // the data to a std::string :
-    std::string output(saveStringStream.str());
-    // Then do the control character replacement:
-    sanitizeForQxml(output);
-    // Now we can use Qt's file handling which does handle non-Latin1 named
-    // files - which MinGW's STL file handling (on Windows platform) does not:
-    file.write(output.data());
+    // as we do not use that library for READING the XML files - and Qt's
+    // file handling does handle non-Latin1 named files - which MinGW's STL
+    // file handling (on Windows platform) does not:
+    const std::string output = renderXml();
+    file.write(output.data(), static_cast<qint64>(output.size()));
     return file.error() == QFileDevice::NoError;
 }
 
 QString XMLexport::saveXml()
 {
-    std::stringstream saveStringStream(std::ios::out);
-    std::string output;
-
-    mExportDoc.save(saveStringStream);
-    output = saveStringStream.str();
-
-    sanitizeForQxml(output);
-
-    return QString::fromStdString(output);
+    return QString::fromStdString(renderXml());
 }
 
 void XMLexport::writeHost(Host* pHost, pugi::xml_node mudletPackage)
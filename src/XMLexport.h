@@ -33,6 +33,8 @@
 #include <pugixml.hpp>
 #include "post_guard.h"
 
+#include <string>
+
 class QFile;
 class Host;
 class LuaInterface;
@@ -67,9 +69,9 @@ public:
     void writeScript(TScript*, pugi::xml_node xmlParent);
     void writeKey(TKey*, pugi::xml_node xmlParent);
     void writeVariable(TVar*, LuaInterface*, VarUnit*, pugi::xml_node xmlParent);
-    void writeModuleXML(const QString& moduleName, const QString& fileName, bool async = false);
+    bool writeModuleXML(const QString& moduleName, const QString& fileName, bool async = false);
 
-    void exportHost(const QString& filename_pugi_xml);
+    void exportHost(const QString& filename_pugi_xml, const QString& previousFileName = QString());
     bool writeGenericPackage(Host* pHost, pugi::xml_node& mMudletPackage, bool ignoreModuleMember = true);
     bool exportProfile(const QString& exportFileName);
     bool exportPackage(const QString &exportFileName, bool ignoreModuleMember = true);
@@ -100,6 +102,9 @@ private:
     TScript* mpScript;
     TKey* mpKey;
     pugi::xml_document mExportDoc;
+    // Set by saveXml(const QString&) when the file already held exactly what
+    // would have been written to it:
+    bool mSaveWasUnchanged = false;
 
     void writeTriggerPackage(const Host* pHost, pugi::xml_node& mMudletPackage, bool skipModuleMembers);
     void writeTimerPackage(const Host* pHost, pugi::xml_node& mMudletPackage, bool skipModuleMembers);
@@ -108,11 +113,11 @@ private:
     void writeScriptPackage(const Host* pHost, pugi::xml_node& mMudletPackage, bool skipModuleMembers);
     void writeKeyPackage(const Host* pHost, pugi::xml_node& mMudletPackage, bool skipModuleMembers);
     void writeVariablePackage(Host* pHost, pugi::xml_node& mMudletPackage);
-    void inline replaceAll(std::string& source, const std::string& from, const std::string& to);
     bool saveXmlFile(QSaveFile& file);
-    bool saveXml(const QString&);
+    bool saveXml(const QString&, const QString& previousFileName = QString());
     pugi::xml_node writeXmlHeader();
-    void sanitizeForQxml(std::string& output);
+    std::string renderXml();
+    static bool fileHoldsText(const QString& fileName, const std::string& text);
     QString saveXml();
     QStringList remapAnsiToColorNumber(const QStringList&, const QList<int>&);
 };
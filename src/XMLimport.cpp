@@ -34,9 +34,14 @@
 
 #include "pre_guard.h"
 #include <QBuffer>
+#include <QtConcurrent>
 #include <QtMath>
 #include "post_guard.h"
 
+extern "C" {
+    #include <lauxlib.h>
+}
+
 XMLimport::XMLimport(Host* pH)
 : mpHost(pH)
 , mPackageName(QString())
@@ -647,9 +652,74 @@ std::pair<dlgTriggerEditor::EditorViewType, int> XMLimport::readPackage()
             }
         }
     }
+    applyDeferredScripts();
     return {objectType, rootItemID};
 }
 
+// Used for the triggers, timers, aliases and keys - which each wrap their
+// script up in a function and only need it compiled into the profile's Lua
+// state before they first run - the scripts themselves are left alone as
+// running them is what sets up everything else:
+template <class T>
+void XMLimport::deferScript(T* pItem, const QString& script, const char* itemType)
+{
+    if (script.isEmpty()) {
+        pItem->setScript(script);
+        return;
+    }
+
+    mDeferredScripts.push_back({qsl("function f() %1\nend").arg(script), [pItem, script, itemType](const bool syntaxIsValid) {
+        if (syntaxIsValid) {
+            // The item will compile it itself when it is first used:
+            pItem->mScript = script;
+            pItem->mNeedsToBeCompiled = true;
+            pItem->mOK_code = true;
+            return;
+        }
+        // Do it now so that the error gets recorded against the item in the
+        // same way as it always has:
+        if (!pItem->setScript(script)) {
+            qDebug().nospace() << "XMLimport::deferScript(...): ERROR: can not compile " << itemType << "'s lua code for: " << pItem->getName();
+        }
+    }});
+}
+
+// Only loads (parses) the code - it is never run - so this can be done on any
+// thread, each of which gets its own Lua state for the purpose:
+bool XMLimport::hasValidLuaSyntax(const QString& code)
+{
+    struct SyntaxCheckState
+    {
+        SyntaxCheckState() : mpState(luaL_newstate()) {}
+        ~SyntaxCheckState() { lua_close(mpState); }
+        lua_State* mpState;
+    };
+    thread_local SyntaxCheckState checker;
+
+    const QByteArray utf8Code = code.toUtf8();
+    const bool isValid = !luaL_loadbuffer(checker.mpState, utf8Code.constData(), utf8Code.size(), "syntax check");
+    lua_settop(checker.mpState, 0);
+    return isValid;
+}
+
+void XMLimport::applyDeferredScripts()
+{
+    if (mDeferredScripts.empty()) {
+        return;
+    }
+
+    QStringList codes;
+    codes.reserve(static_cast<int>(mDeferredScripts.size()));
+    for (const auto& deferredScript : mDeferredScripts) {
+        codes.append(deferredScript.mCode);
+    }
+    const QList<bool> results = QtConcurrent::blockingMapped<QList<bool>>(codes, &XMLimport::hasValidLuaSyntax);
+    for (int i = 0, total = results.size(); i < total; ++i) {
+        mDeferredScripts.at(i).mApply(results.at(i));
+    }
+    mDeferredScripts.clear();
+}
+
 void XMLimport::readHelpPackage()
 {
     while (!atEnd()) {
@@ -1258,10 +1328,7 @@ int XMLimport::readTrigger(TTrigger* pParent)
             if (name() == qsl("name")) {
                 pT->setName(readElementText());
             } else if (name() == qsl("script")) {
-                const QString tempScript = readScriptElement();
-                if (!pT->setScript(tempScript)) {
-                    qDebug().nospace() << "XMLimport::readTrigger(...): ERROR: can not compile trigger's lua code for: " << pT->getName();
-                }
+                deferScript(pT, readScriptElement(), "trigger");
             } else if (name() == qsl("packageName")) {
                 pT->mPackageName = readElementText();
             } else if (name() == qsl("triggerType")) {
@@ -1370,10 +1437,7 @@ int XMLimport::readTimer(TTimer* pParent)
             } else if (name() == qsl("packageName")) {
                 pT->mPackageName = readElementText();
             } else if (name() == qsl("script")) {
-                const QString tempScript = readScriptElement();
-                if (!pT->setScript(tempScript)) {
-                    qDebug().nospace() << "XMLimport::readTimer(...): ERROR: can not compile timer's lua code for: " << pT->getName();
-                }
+                deferScript(pT, readScriptElement(), "timer");
             } else if (name() == qsl("command")) {
                 pT->mCommand = readElementText();
             } else if (name() == qsl("time")) {
@@ -1438,10 +1502,7 @@ int XMLimport::readAlias(TAlias* pParent)
             } else if (name() == qsl("packageName")) {
                 pT->mPackageName = readElementText();
             } else if (name() == qsl("script")) {
-                const QString tempScript = readScriptElement();
-                if (!pT->setScript(tempScript)) {
-                    qDebug().nospace() << "XMLimport::readAlias(...): ERROR: can not compile alias's lua code for: " << pT->getName();
-                }
+                deferScript(pT, readScriptElement(), "alias");
             } else if (name() == qsl("command")) {
                 pT->mCommand = readElementText();
             } else if (name() == qsl("regex")) {
@@ -1656,10 +1717,7 @@ int XMLimport::readKey(TKey* pParent)
             } else if (name() == qsl("packageName")) {
                 pT->mPackageName = readElementText();
             } else if (name() == qsl("script")) {
-                const QString tempScript = readScriptElement();
-                if (!pT->setScript(tempScript)) {
-                    qDebug().nospace() << "XMLimport::readKey(...): ERROR: can not compile key's lua code for: " << pT->getName();
-                }
+                deferScript(pT, readScriptElement(), "key");
             } else if (name() == qsl("command")) {
                 pT->mCommand = readElementText();
             } else if (name() == qsl("keyCode")) {
@@ -37,6 +37,9 @@
 #include <QClipboard>
 #include "post_guard.h"
 
+#include <functional>
+#include <vector>
+
 class Host;
 class TAction;
 class TAlias;
@@ -108,6 +111,11 @@ private:
 
     bool readDefaultTrueBool(QString name);
 
+    template <class T>
+    void deferScript(T*, const QString& script, const char* itemType);
+    void applyDeferredScripts();
+    static bool hasValidLuaSyntax(const QString& code);
+
     QPointer<Host> mpHost;
     QString mPackageName;
     TTrigger* mpTrigger;
@@ -127,6 +135,16 @@ private:
     int mMaxRoomId;
     quint8 mVersionMajor;
     quint16 mVersionMinor; // Cannot be a quint8 as that only allows x.255 for the decimal
+
+    // The Lua code for the items read so far - rather than compiling each one
+    // into the profile's Lua state as it is read these are all checked for
+    // syntax errors, in parallel, once the package has been read:
+    struct DeferredScript
+    {
+        QString mCode;
+        std::function<void(bool)> mApply;
+    };
+    std::vector<DeferredScript> mDeferredScripts;
 };
 
 #endif // MUDLET_XMLEXPORT_H
@@ -39,6 +39,7 @@
 #include "TMedia.h"
 #include "GMCPAuthenticator.h"
 #include "TTextCodec.h"
+#include "TTextEdit.h"
 #include "dlgComposer.h"
 #include "dlgMapper.h"
 #include "mudlet.h"
@@ -56,10 +57,15 @@
 #include <QSslError>
 #include "post_guard.h"
 
+#include <algorithm>
+
 using namespace std::chrono_literals;
 
 
 constexpr size_t BUFFER_SIZE = 100000L;
+// The longest time, in milliseconds, that received data will be processed for
+// before returning to the event loop to let the GUI catch up:
+constexpr qint64 RECEIVE_SLICE_MSECS = 50;
 // TODO: https://github.com/Mudlet/Mudlet/issues/5780 (1 of 7) - investigate switching from using `char[]` to `std::array<char>`
 char loadBuffer[BUFFER_SIZE + 1];
 int loadedBytes;
@@ -147,6 +153,9 @@ void cTelnet::reset()
     mGA_Driver = false;
     command = "";
     mMudData = "";
+    mReceiveQueue.clear();
+    mReceiveBacklogBytes = 0;
+    mIsDisconnectPending = false;
 }
 
 
@@ -488,6 +497,16 @@ void cTelnet::slot_socketDisconnected()
     QString spacer = "    ";
     bool sslerr = false;
 
+    // Make sure everything the server sent before it went away is shown
+    // before the disconnection messages - if we have got here from a script
+    // spinning the event loop part way through processing the queue then
+    // the outer processReceiveQueue() call has to finish that first, and it
+    // will call back here once it has:
+    if (mIsProcessingReceiveQueue) {
+        mIsDisconnectPending = true;
+        return;
+    }
+    processReceiveQueue(true);
     postData();
 
     emit signal_disconnected(mpHost);
@@ -3351,7 +3370,15 @@ void cTelnet::slot_timerPosting()
 void cTelnet::postData()
 {
     if (mpHost->mpConsole) {
-        mpHost->mpConsole->printOnDisplay(mMudData, true);
+        if (mReplayIsUnpaced) {
+            mReplayLines += std::count(mMudData.cbegin(), mMudData.cend(), '\n');
+            QElapsedTimer processingTimer;
+            processingTimer.start();
+            mpHost->mpConsole->printOnDisplay(mMudData, true);
+            mReplayProcessingNSecs += processingTimer.nsecsElapsed();
+        } else {
+            mpHost->mpConsole->printOnDisplay(mMudData, true);
+        }
     }
     if (mAlertOnNewData) {
         QApplication::alert(mudlet::self(), 0);
@@ -3412,7 +3439,7 @@ void cTelnet::recordReplay()
     mRecordingChunkCount = 0;
 }
 
-bool cTelnet::loadReplay(const QString& name, QString* pErrMsg)
+bool cTelnet::loadReplay(const QString& name, QString* pErrMsg, const bool unpaced, const bool render)
 {
     replayFile.setFileName(name);
     if (replayFile.open(QIODevice::ReadOnly)) {
@@ -3434,8 +3461,14 @@ bool cTelnet::loadReplay(const QString& name, QString* pErrMsg)
             auto [ok, modifiedFormat] = testReadReplayFile();
             if (Q_LIKELY(ok)) {
                 mReplayHasFaultyFormat = modifiedFormat;
-                // This initiates the replay chunk reading/processing cycle:
-                loadReplayChunk();
+                mReplayIsUnpaced = unpaced;
+                mReplayRenders = !unpaced || render;
+                if (unpaced) {
+                    runUnpacedReplay();
+                } else {
+                    // This initiates the replay chunk reading/processing cycle:
+                    loadReplayChunk();
+                }
             } else {
                 // Amelioration code should now prevent this from happening
                 loadingReplay = false;
@@ -3479,40 +3512,136 @@ bool cTelnet::loadReplay(const QString& name, QString* pErrMsg)
 // TODO: https://github.com/Mudlet/Mudlet/issues/5779 - consider enhancing replay system, possibly using the QTimeLine class
 void cTelnet::loadReplayChunk()
 {
-    if (!replayStream.atEnd()) {
-        qint32 amount = 0;
-        qint32 offset = 0;
-        if (mReplayHasFaultyFormat) {
-            qint64 temp = 0;
-            replayStream >> temp;
-            // 2^30 milliseconds is over 12 days so that sort of delay between
-            // steps is not likely - and only using a 32 bit integer type is
-            // going to be okay:
-            offset = static_cast<qint32>(temp);
-        } else {
-            replayStream >> offset;
-        }
+    qint32 offset = 0;
+    if (readReplayChunk(offset)) {
+        QTimer::singleShot(offset / mudlet::self()->mReplaySpeed, this, &cTelnet::slot_processReplayChunk);
+    } else {
+        endReplay();
+    }
+}
 
-        replayStream >> amount;
+// Reads the next recorded chunk into loadBuffer, returning false once the end
+// of the replay file has been reached:
+bool cTelnet::readReplayChunk(qint32& offset)
+{
+    if (replayStream.atEnd()) {
+        return false;
+    }
 
-        loadedBytes = replayStream.readRawData(loadBuffer, amount);
-        // Previous use of loadedBytes + 1 caused a spurious character at end of
-        // string display by a qDebug of the loadBuffer contents
-        loadBuffer[loadedBytes] = '\0';
-        mudlet::self()->mReplayTime = mudlet::self()->mReplayTime.addMSecs(offset);
-        QTimer::singleShot(offset / mudlet::self()->mReplaySpeed, this, &cTelnet::slot_processReplayChunk);
+    qint32 amount = 0;
+    offset = 0;
+    if (mReplayHasFaultyFormat) {
+        qint64 temp = 0;
+        replayStream >> temp;
+        // 2^30 milliseconds is over 12 days so that sort of delay between
+        // steps is not likely - and only using a 32 bit integer type is
+        // going to be okay:
+        offset = static_cast<qint32>(temp);
     } else {
-        loadingReplay = false;
-        replayFile.close();
-        if (!mIsReplayRunFromLua) {
-            postMessage(tr("[  OK  ]  - The replay has ended."));
-        }
-        mudlet::self()->replayOver();
+        replayStream >> offset;
+    }
+
+    replayStream >> amount;
+
+    loadedBytes = replayStream.readRawData(loadBuffer, amount);
+    // Previous use of loadedBytes + 1 caused a spurious character at end of
+    // string display by a qDebug of the loadBuffer contents
+    loadBuffer[loadedBytes] = '\0';
+    mudlet::self()->mReplayTime = mudlet::self()->mReplayTime.addMSecs(offset);
+    return true;
+}
+
+void cTelnet::endReplay()
+{
+    loadingReplay = false;
+    mReplayIsUnpaced = false;
+    mReplayRenders = true;
+    replayFile.close();
+    if (!mIsReplayRunFromLua) {
+        postMessage(tr("[  OK  ]  - The replay has ended."));
+    }
+    mudlet::self()->replayOver();
+}
+
+// Feeds the whole replay file through the same processing as a paced replay
+// but without waiting for the recorded delays (or the event loop) between
+// chunks, then reports how long each stage took:
+void cTelnet::runUnpacedReplay()
+{
+    mReplayLines = 0;
+    mReplayBytes = 0;
+    mReplayReadingNSecs = 0;
+    mReplayTelnetNSecs = 0;
+    mReplayProcessingNSecs = 0;
+    mReplayRenderingNSecs = 0;
+    QElapsedTimer wallTimer;
+    wallTimer.start();
+
+    qint32 offset = 0;
+    QElapsedTimer readingTimer;
+    readingTimer.start();
+    while (readReplayChunk(offset)) {
+        mReplayReadingNSecs += readingTimer.nsecsElapsed();
+        mReplayBytes += loadedBytes;
+        processReplayChunk();
+        readingTimer.start();
+    }
+    mReplayReadingNSecs += readingTimer.nsecsElapsed();
+
+    if (!mReplayRenders && mpHost->mpConsole) {
+        renderUnpacedReplay();
+    }
+
+    const qint64 totalNSecs = wallTimer.nsecsElapsed();
+    const double totalSecs = totalNSecs / 1.0e9;
+    const double linesPerSec = totalNSecs > 0 ? mReplayLines / totalSecs : 0.0;
+    mReplayReport = tr("[ INFO ]  - Unpaced replay of %1 bytes (%2 lines) took %3 seconds, %4 lines per second.\n"
+                       "Reading the file: %5 ms, telnet decoding: %6 ms, text and trigger processing: %7 ms, rendering: %8 ms.")
+                            .arg(QString::number(mReplayBytes),
+                                 QString::number(mReplayLines),
+                                 QString::number(totalSecs, 'f', 3),
+                                 QString::number(linesPerSec, 'f', 0),
+                                 QString::number(mReplayReadingNSecs / 1.0e6, 'f', 1),
+                                 QString::number(mReplayTelnetNSecs / 1.0e6, 'f', 1),
+                                 QString::number(mReplayProcessingNSecs / 1.0e6, 'f', 1),
+                                 QString::number(mReplayRenderingNSecs / 1.0e6, 'f', 1));
+    qDebug().noquote().nospace() << "cTelnet::runUnpacedReplay() INFO - " << mReplayReport;
+    if (!mIsReplayRunFromLua) {
+        postMessage(mReplayReport);
     }
+    endReplay();
+}
+
+// The event loop does not get to run during an unpaced replay, so the repaint
+// that finalize() only asks for would not otherwise happen until the end and
+// the time it takes would not be measured at all; instead do it here and now:
+void cTelnet::renderUnpacedReplay()
+{
+    QElapsedTimer renderTimer;
+    renderTimer.start();
+    mpHost->mpConsole->finalize();
+    mpHost->mpConsole->mUpperPane->repaint();
+    mpHost->mpConsole->mLowerPane->repaint();
+    mReplayRenderingNSecs += renderTimer.nsecsElapsed();
 }
 
 void cTelnet::slot_processReplayChunk()
 {
+    processReplayChunk();
+    if (loadingReplay) {
+        loadReplayChunk();
+    }
+}
+
+void cTelnet::processReplayChunk()
+{
+    // For an unpaced replay the time spent here, less that spent passing the
+    // decoded text on to be processed, is the telnet decoding time:
+    QElapsedTimer decodingTimer;
+    const qint64 processingNSecsBefore = mReplayProcessingNSecs;
+    if (mReplayIsUnpaced) {
+        decodingTimer.start();
+    }
     int datalen = loadedBytes;
     std::string cleandata = "";
     recvdGA = false;
@@ -3597,9 +3726,18 @@ void cTelnet::slot_processReplayChunk()
         gotRest(cleandata);
     }
 
-    mpHost->mpConsole->finalize();
-    if (loadingReplay) {
-        loadReplayChunk();
+    if (mReplayIsUnpaced) {
+        mReplayTelnetNSecs += decodingTimer.nsecsElapsed() - (mReplayProcessingNSecs - processingNSecsBefore);
+    }
+
+    if (!mReplayRenders) {
+        return;
+    }
+
+    if (mReplayIsUnpaced) {
+        renderUnpacedReplay();
+    } else {
+        mpHost->mpConsole->finalize();
     }
 }
 
@@ -3610,11 +3748,61 @@ void cTelnet::slot_socketReadyToBeRead()
         mWaitingForResponse = false;
     }
 
+    const QByteArray incoming = socket.readAll();
+    if (incoming.isEmpty()) {
+        return;
+    }
+
+    mReceiveBacklogBytes += incoming.size();
+    mReceiveQueue.push_back(incoming);
+    // If we are already working through the queue (this can be re-entered if
+    // a script spins the event loop) or a slice is already pending then the
+    // new data will be picked up in order from there:
+    if (!mIsProcessingReceiveQueue && !mIsReceiveQueueProcessingScheduled) {
+        processReceiveQueue();
+    }
+}
+
+// Runs queued socket data through processSocketData(...) in arrival order,
+// handing control back to the event loop after RECEIVE_SLICE_MSECS unless
+// drainAll is set, so painting and user input are not starved by a burst:
+void cTelnet::processReceiveQueue(const bool drainAll)
+{
+    mIsReceiveQueueProcessingScheduled = false;
+    if (mIsProcessingReceiveQueue) {
+        return;
+    }
+
+    mIsProcessingReceiveQueue = true;
+    QElapsedTimer sliceTimer;
+    sliceTimer.start();
     // TODO: https://github.com/Mudlet/Mudlet/issues/5780 (2 of 7) - investigate switching from using `char[]` to `std::array<char>`
     char in_buffer[BUFFER_SIZE + 10];
+    while (!mReceiveQueue.empty()) {
+        QByteArray& chunk = mReceiveQueue.front();
+        const int amount = std::min(chunk.size(), static_cast<int>(BUFFER_SIZE));
+        memcpy(in_buffer, chunk.constData(), amount);
+        if (amount == chunk.size()) {
+            mReceiveQueue.pop_front();
+        } else {
+            chunk.remove(0, amount);
+        }
+        mReceiveBacklogBytes -= amount;
 
-    int amount = socket.read(in_buffer, BUFFER_SIZE);
-    processSocketData(in_buffer, amount);
+        processSocketData(in_buffer, amount);
+
+        if (!drainAll && !mIsDisconnectPending && !mReceiveQueue.empty() && sliceTimer.elapsed() > RECEIVE_SLICE_MSECS) {
+            mIsReceiveQueueProcessingScheduled = true;
+            QTimer::singleShot(0, this, [this]() { processReceiveQueue(); });
+            break;
+        }
+    }
+    mIsProcessingReceiveQueue = false;
+
+    if (mIsDisconnectPending) {
+        mIsDisconnectPending = false;
+        slot_socketDisconnected();
+    }
 }
 
 void cTelnet::processSocketData(char* in_buffer, int amount, const bool loopbackTesting)
@@ -48,6 +48,7 @@
 
 #include <zlib.h>
 
+#include <deque>
 #include <iostream>
 #include <queue>
 #include <string>
@@ -196,9 +197,11 @@ public:
     void set_USE_IRE_DRIVER_BUGFIX(bool b) { mUSE_IRE_DRIVER_BUGFIX = b; }
     void setDontReconnect(bool b) { mDontReconnect = b; }
     void recordReplay();
-    bool loadReplay(const QString&, QString* pErrMsg = nullptr);
+    bool loadReplay(const QString&, QString* pErrMsg = nullptr, bool unpaced = false, bool render = true);
     void loadReplayChunk();
     bool isReplaying() { return loadingReplay; }
+    // Summary of the timings gathered during the last unpaced replay:
+    const QString& getReplayReport() const { return mReplayReport; }
     void setChannel102Variables(const QString&);
     bool socketOutRaw(std::string& data);
     const QByteArray & getEncoding() const { return mEncoding; }
@@ -228,6 +231,9 @@ public:
     void setPostingTimeout(const int);
     int getPostingTimeout() const { return mTimeOut; }
     void loopbackTest(QByteArray& data) { processSocketData(data.data(), data.size(), true); }
+    // Number of bytes read from the socket that are still waiting to be run
+    // through the telnet/trigger processing:
+    qint64 getReceiveBacklog() const { return mReceiveBacklogBytes; }
     void cancelLoginTimers();
 
 
@@ -274,6 +280,7 @@ private:
     // loopbackTesting is for internal testing whilst OFF-LINE using the
     // feedTelnet(...) Lua function.
     void processSocketData(char *data, int size, const bool loopbackTesting = false);
+    void processReceiveQueue(const bool drainAll = false);
     void initStreamDecompressor();
     int decompressBuffer(char*& in_buffer, int& length, char* out_buffer);
     void reset();
@@ -319,6 +326,11 @@ private:
 #endif
     void sendNAWS(int width, int height);
     static std::pair<bool, bool> testReadReplayFile();
+    bool readReplayChunk(qint32& offset);
+    void processReplayChunk();
+    void runUnpacedReplay();
+    void renderUnpacedReplay();
+    void endReplay();
 
 
     QPointer<Host> mpHost;
@@ -337,6 +349,16 @@ private:
     int hostPort = 0;
     bool mWaitingForResponse = false;
     std::queue<int> mCommandQueue;
+    // Data read from the socket but not yet processed - it is worked through
+    // in time-limited slices so that a large burst from the server does not
+    // stop the GUI from repainting or handling input until it is all done:
+    std::deque<QByteArray> mReceiveQueue;
+    qint64 mReceiveBacklogBytes = 0;
+    bool mIsProcessingReceiveQueue = false;
+    bool mIsReceiveQueueProcessingScheduled = false;
+    // Set if the socket disconnected whilst the receive queue was being
+    // processed, so that the disconnection is handled once it has drained:
+    bool mIsDisconnectPending = false;
 
     z_stream mZstream = {};
 
@@ -402,6 +424,19 @@ private:
     bool loadingReplay = false;
     // Used to disable the TConsole ending messages if run from lua:
     bool mIsReplayRunFromLua = false;
+    // Set when a replay ignores the recorded delays and is run through in one
+    // go to measure how fast the incoming data can be handled:
+    bool mReplayIsUnpaced = false;
+    // Can be cleared for an unpaced replay so that the main console is only
+    // redrawn once at the end:
+    bool mReplayRenders = true;
+    qint64 mReplayLines = 0;
+    qint64 mReplayBytes = 0;
+    qint64 mReplayReadingNSecs = 0;
+    qint64 mReplayTelnetNSecs = 0;
+    qint64 mReplayProcessingNSecs = 0;
+    qint64 mReplayRenderingNSecs = 0;
+    QString mReplayReport;
     QByteArrayList mAcceptableEncodings;
     // Used to prevent more than one warning being shown in the event of a bad
     // encoding (when the user wants to use characters that cannot be encoded in
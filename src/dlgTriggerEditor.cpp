@@ -45,12 +45,17 @@
 #include "mudlet.h"
 
 #include "pre_guard.h"
+#include <QCheckBox>
 #include <QColorDialog>
+#include <QDialogButtonBox>
 #include <QFileDialog>
+#include <QHeaderView>
 #include <QMessageBox>
+#include <QPushButton>
 #include <QScrollBar>
 #include <QShortcut>
 #include <QToolBar>
+#include <QVBoxLayout>
 #include "post_guard.h"
 
 using namespace std::chrono_literals;
@@ -449,6 +454,11 @@ dlgTriggerEditor::dlgTriggerEditor(Host* pH)
     viewStatsAction->setToolTip(qsl("%1 (%2)").arg(tr("Generate statistics"), tr("Ctrl+9")));
     connect(viewStatsAction, &QAction::triggered, this, &dlgTriggerEditor::slot_viewStatsAction);
 
+    QAction* viewProfilerAction = new QAction(QIcon(qsl(":/icons/chronometer.png")), tr("Profiler"), this);
+    viewProfilerAction->setStatusTip(tr("Show how much time each trigger, alias, timer, key and event handler is taking to run."));
+    viewProfilerAction->setToolTip(tr("Show the profiler"));
+    connect(viewProfilerAction, &QAction::triggered, this, &dlgTriggerEditor::slot_viewProfilerAction);
+
     QAction* showDebugAreaAction = new QAction(QIcon(qsl(":/icons/tools-report-bug.png")), tr("Debug"), this);
     showDebugAreaAction->setStatusTip(tr("Show/Hide the separate Central Debug Console - when being displayed the system will be slower."));
     showDebugAreaAction->setToolTip(utils::richText(tr("Show/Hide Debug Console (Ctrl+0) -> system will be <b><i>slower</i></b>.")));
@@ -614,6 +624,7 @@ dlgTriggerEditor::dlgTriggerEditor(Host* pH)
 
     toolBar2->addAction(viewErrorsAction);
     toolBar2->addAction(viewStatsAction);
+    toolBar2->addAction(viewProfilerAction);
     toolBar2->addAction(showDebugAreaAction);
 
     toolBar2->setMovable(true);
@@ -915,6 +926,83 @@ void dlgTriggerEditor::slot_viewStatsAction()
     mudlet::self()->raise();
 }
 
+void dlgTriggerEditor::slot_viewProfilerAction()
+{
+    if (!mpProfilerDialog) {
+        mpProfilerDialog = new QDialog(this);
+        mpProfilerDialog->setAttribute(Qt::WA_DeleteOnClose);
+        //: Title of the dialog showing the per item timings, %1 is the profile name
+        mpProfilerDialog->setWindowTitle(tr("Profiler - %1").arg(mpHost->getName()));
+        auto pLayout = new QVBoxLayout(mpProfilerDialog);
+
+        auto pCheckBox_enable = new QCheckBox(tr("Collect timings (slows the system down slightly)"), mpProfilerDialog);
+        pCheckBox_enable->setChecked(mpHost->mProfiler.isEnabled());
+        connect(pCheckBox_enable, &QCheckBox::toggled, this, [this](const bool state) { mpHost->mProfiler.setEnabled(state); });
+        pLayout->addWidget(pCheckBox_enable);
+
+        mpProfilerTable = new QTableWidget(mpProfilerDialog);
+        mpProfilerTable->setColumnCount(8);
+        mpProfilerTable->setHorizontalHeaderLabels({tr("Type"), tr("ID"), tr("Name"), tr("Calls"),
+                                                    //: The times are in milliseconds
+                                                    tr("Total (ms)"), tr("Max (ms)"), tr("Matching (ms)"), tr("Lua (ms)")});
+        mpProfilerTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        mpProfilerTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+        mpProfilerTable->verticalHeader()->setVisible(false);
+        mpProfilerTable->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Stretch);
+        pLayout->addWidget(mpProfilerTable);
+
+        auto pButtonBox = new QDialogButtonBox(QDialogButtonBox::Close | QDialogButtonBox::Reset, mpProfilerDialog);
+        auto pButton_refresh = pButtonBox->addButton(tr("Refresh"), QDialogButtonBox::ActionRole);
+        connect(pButton_refresh, &QPushButton::clicked, this, &dlgTriggerEditor::populateProfilerTable);
+        connect(pButtonBox->button(QDialogButtonBox::Reset), &QPushButton::clicked, this, [this]() {
+            mpHost->mProfiler.reset();
+            populateProfilerTable();
+        });
+        connect(pButtonBox, &QDialogButtonBox::rejected, mpProfilerDialog, &QDialog::close);
+        pLayout->addWidget(pButtonBox);
+        mpProfilerDialog->resize(800, 500);
+    }
+
+    populateProfilerTable();
+    mpProfilerDialog->show();
+    mpProfilerDialog->raise();
+    mpProfilerDialog->activateWindow();
+}
+
+void dlgTriggerEditor::populateProfilerTable()
+{
+    if (!mpProfilerTable) {
+        return;
+    }
+
+    const QList<TProfiler::Stats> stats = mpHost->mProfiler.getStats();
+    // Sorting has to be off whilst filling the table otherwise the rows get
+    // rearranged under us:
+    mpProfilerTable->setSortingEnabled(false);
+    mpProfilerTable->clearContents();
+    mpProfilerTable->setRowCount(stats.size());
+    auto numberItem = [](const QVariant& value) {
+        auto pItem = new QTableWidgetItem();
+        pItem->setData(Qt::DisplayRole, value);
+        pItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        return pItem;
+    };
+    int row = 0;
+    for (const auto& item : stats) {
+        mpProfilerTable->setItem(row, 0, new QTableWidgetItem(TProfiler::typeName(item.mType)));
+        mpProfilerTable->setItem(row, 1, item.mId >= 0 ? numberItem(item.mId) : new QTableWidgetItem());
+        mpProfilerTable->setItem(row, 2, new QTableWidgetItem(item.mName));
+        mpProfilerTable->setItem(row, 3, numberItem(item.mCalls));
+        mpProfilerTable->setItem(row, 4, numberItem(item.mTotalTime / 1.0e6));
+        mpProfilerTable->setItem(row, 5, numberItem(item.mMaxTime / 1.0e6));
+        mpProfilerTable->setItem(row, 6, numberItem(item.mMatchTime / 1.0e6));
+        mpProfilerTable->setItem(row, 7, numberItem(item.mScriptTime / 1.0e6));
+        ++row;
+    }
+    mpProfilerTable->setSortingEnabled(true);
+    mpProfilerTable->sortByColumn(4, Qt::DescendingOrder);
+}
+
 void dlgTriggerEditor::slot_viewErrorsAction()
 {
     mpErrorConsole->setVisible(!mpErrorConsole->isVisible());
@@ -1425,6 +1513,17 @@ void dlgTriggerEditor::slot_searchMudletItems(const int index)
     mpSourceEditorEdbee->controller()->update();
 }
 
+// Splits the source into lines for the per-line search only if the text is in
+// there at all - most scripts will not contain it and then splitting them is
+// the bulk of the work:
+QStringList dlgTriggerEditor::linesToSearch(const QString& source, const QString& text) const
+{
+    if (!source.contains(text, ((mSearchOptions & SearchOptionCaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive))) {
+        return {};
+    }
+    return source.split(QChar::LineFeed);
+}
+
 void dlgTriggerEditor::searchVariables(const QString& text)
 {
     if (mCurrentView != EditorViewType::cmVarsView) {
@@ -1557,7 +1656,7 @@ void dlgTriggerEditor::searchKeys(const QString& text)
         }
 
         // Script content
-        const QStringList textList = key->getScript().split("\n");
+        const QStringList textList = linesToSearch(key->getScript(), text);
         const int total = textList.count();
         for (int index = 0; index < total; ++index) {
             // CHECK: This may NOT be an optimisation...!
@@ -1629,7 +1728,7 @@ void dlgTriggerEditor::searchTimers(const QString& text)
         }
 
         // Script content
-        const QStringList textList = timer->getScript().split("\n");
+        const QStringList textList = linesToSearch(timer->getScript(), text);
         const int total = textList.count();
         for (int index = 0; index < total; ++index) {
             // CHECK: This may NOT be an optimisation...!
@@ -1721,7 +1820,7 @@ void dlgTriggerEditor::searchActions(const QString& text)
         }
 
         // Css / StyleSheet
-        QStringList textList = action->css.split("\n");
+        QStringList textList = linesToSearch(action->css, text);
         int total = textList.count();
         for (int index = 0; index < total; ++index) {
             // CHECK: This may NOT be an optimisation...!
@@ -1751,7 +1850,7 @@ void dlgTriggerEditor::searchActions(const QString& text)
         }
 
         // Script content - now put last
-        textList = action->getScript().split("\n");
+        textList = linesToSearch(action->getScript(), text);
         total = textList.count();
         for (int index = 0; index < total; ++index) {
             // CHECK: This may NOT be an optimisation...!
@@ -1835,7 +1934,7 @@ void dlgTriggerEditor::searchScripts(const QString& text)
         }
 
         // Script content
-        textList = script->getScript().split("\n");
+        textList = linesToSearch(script->getScript(), text);
         total = textList.count();
         for (int index = 0; index < total; ++index) {
             // CHECK: This may NOT be an optimisation...!
@@ -1922,7 +2021,7 @@ void dlgTriggerEditor::searchAliases(const QString& text)
         }
 
         // Script content - now put last
-        const QStringList textList = alias->getScript().split("\n");
+        const QStringList textList = linesToSearch(alias->getScript(), text);
         const int total = textList.count();
         for (int index = 0; index < total; ++index) {
             // CHECK: This may NOT be an optimisation...!
@@ -2024,7 +2123,7 @@ void dlgTriggerEditor::searchTriggers(const QString& text)
         }
 
         // Script content - now put last
-        textList = trigger->getScript().split("\n");
+        textList = linesToSearch(trigger->getScript(), text);
         total = textList.count();
         for (int index = 0; index < total; ++index) {
             // CHECK: This may NOT be an optimisation...!
@@ -2125,7 +2224,7 @@ void dlgTriggerEditor::recursiveSearchTriggers(TTrigger* pTriggerParent, const Q
         }
 
         // Script content - now put last
-        textList = trigger->getScript().split("\n");
+        textList = linesToSearch(trigger->getScript(), text);
         total = textList.count();
         for (int index = 0; index < total; ++index) {
             if (textList.at(index).isEmpty() || !textList.at(index).contains(text, ((mSearchOptions & SearchOptionCaseSensitive) ? Qt::CaseSensitive : Qt::CaseInsensitive))) {
@@ -2217,7 +2316,7 @@ void dlgTriggerEditor::recursiveSearchAlias(TAlias* pTriggerParent, const QStrin
         }
 
         // Script content - now put last
-        const QStringList textList = alias->getScript().split("\n");
+        const QStringList textList = linesToSearch(alias->getScript(), text);
         const int total = textList.count();
         for (int index = 0; index < total; ++index) {
             // CHECK: This may NOT be an optimisation...!
@@ -2303,7 +2402,7 @@ void dlgTriggerEditor::recursiveSearchScripts(TScript* pTriggerParent, const QSt
         }
 
         // Script content
-        textList = script->getScript().split("\n");
+        textList = linesToSearch(script->getScript(), text);
         total = textList.count();
         for (int index = 0; index < total; ++index) {
             // CHECK: This may NOT be an optimisation...!
@@ -2397,7 +2496,7 @@ void dlgTriggerEditor::recursiveSearchActions(TAction* pTriggerParent, const QSt
         }
 
         // Css / StyleSheet
-        QStringList textList = action->css.split("\n");
+        QStringList textList = linesToSearch(action->css, text);
         int total = textList.count();
         for (int index = 0; index < total; ++index) {
             // CHECK: This may NOT be an optimisation...!
@@ -2427,7 +2526,7 @@ void dlgTriggerEditor::recursiveSearchActions(TAction* pTriggerParent, const QSt
         }
 
         // Script content - now put last
-        textList = action->getScript().split("\n");
+        textList = linesToSearch(action->getScript(), text);
         total = textList.count();
         for (int index = 0; index < total; ++index) {
             // CHECK: This may NOT be an optimisation...!
@@ -2501,7 +2600,7 @@ void dlgTriggerEditor::recursiveSearchTimers(TTimer* pTriggerParent, const QStri
         }
 
         // Script content
-        const QStringList textList = timer->getScript().split("\n");
+        const QStringList textList = linesToSearch(timer->getScript(), text);
         const int total = textList.count();
         for (int index = 0; index < total; ++index) {
             // CHECK: This may NOT be an optimisation...!
@@ -2575,7 +2674,7 @@ void dlgTriggerEditor::recursiveSearchKeys(TKey* pTriggerParent, const QString&
         }
 
         // Script content
-        const QStringList textList = key->getScript().split("\n");
+        const QStringList textList = linesToSearch(key->getScript(), text);
         const int total = textList.count();
         for (int index = 0; index < total; ++index) {
             // CHECK: This may NOT be an optimisation...!
@@ -6498,38 +6597,40 @@ void dlgTriggerEditor::fillout_form()
     mNeedUpdateData = false;
     mpTriggerBaseItem = new QTreeWidgetItem(static_cast<QTreeWidgetItem*>(nullptr), QStringList(tr("Triggers")));
     mpTriggerBaseItem->setIcon(0, QPixmap(qsl(":/icons/tools-wizard.png")));
-    treeWidget_triggers->insertTopLevelItem(0, mpTriggerBaseItem);
+    // Each base item is filled before it goes into its tree so that the view
+    // is told about the whole branch once instead of about every item:
     populateTriggers();
+    treeWidget_triggers->insertTopLevelItem(0, mpTriggerBaseItem);
     mpTriggerBaseItem->setExpanded(true);
 
     mpTimerBaseItem = new QTreeWidgetItem(static_cast<QTreeWidgetItem*>(nullptr), QStringList(tr("Timers")));
     mpTimerBaseItem->setIcon(0, QPixmap(qsl(":/icons/chronometer.png")));
-    treeWidget_timers->insertTopLevelItem(0, mpTimerBaseItem);
     populateTimers();
+    treeWidget_timers->insertTopLevelItem(0, mpTimerBaseItem);
     mpTimerBaseItem->setExpanded(true);
 
     mpScriptsBaseItem = new QTreeWidgetItem(static_cast<QTreeWidgetItem*>(nullptr), QStringList(tr("Scripts")));
     mpScriptsBaseItem->setIcon(0, QPixmap(qsl(":/icons/accessories-text-editor.png")));
-    treeWidget_scripts->insertTopLevelItem(0, mpScriptsBaseItem);
     populateScripts();
+    treeWidget_scripts->insertTopLevelItem(0, mpScriptsBaseItem);
     mpScriptsBaseItem->setExpanded(true);
 
     mpAliasBaseItem = new QTreeWidgetItem(static_cast<QTreeWidgetItem*>(nullptr), QStringList(tr("Aliases - Input Triggers")));
     mpAliasBaseItem->setIcon(0, QPixmap(qsl(":/icons/system-users.png")));
-    treeWidget_aliases->insertTopLevelItem(0, mpAliasBaseItem);
     populateAliases();
+    treeWidget_aliases->insertTopLevelItem(0, mpAliasBaseItem);
     mpAliasBaseItem->setExpanded(true);
 
     mpActionBaseItem = new QTreeWidgetItem(static_cast<QTreeWidgetItem*>(nullptr), QStringList(tr("Buttons")));
     mpActionBaseItem->setIcon(0, QPixmap(qsl(":/icons/bookmarks.png")));
-    treeWidget_actions->insertTopLevelItem(0, mpActionBaseItem);
     populateActions();
+    treeWidget_actions->insertTopLevelItem(0, mpActionBaseItem);
     mpActionBaseItem->setExpanded(true);
 
     mpKeyBaseItem = new QTreeWidgetItem(static_cast<QTreeWidgetItem*>(nullptr), QStringList(tr("Key Bindings")));
     mpKeyBaseItem->setIcon(0, QPixmap(qsl(":/icons/preferences-desktop-keyboard.png")));
-    treeWidget_keys->insertTopLevelItem(0, mpKeyBaseItem);
     populateKeys();
+    treeWidget_keys->insertTopLevelItem(0, mpKeyBaseItem);
     mpKeyBaseItem->setExpanded(true);
 }
 
@@ -52,6 +52,7 @@
 #include <QFlag>
 #include <QListWidgetItem>
 #include <QScrollArea>
+#include <QTableWidget>
 #include <QTreeWidget>
 #include "post_guard.h"
 
@@ -243,6 +244,7 @@ public slots:
     void slot_export();
     void slot_import();
     void slot_viewStatsAction();
+    void slot_viewProfilerAction();
     void slot_toggleCentralDebugConsole();
     void slot_nextSection();
     void slot_previousSection();
@@ -316,6 +318,7 @@ public:
     bool mNeedUpdateData = false;
 
 private:
+    void populateProfilerTable();
     void populateTriggers();
     void populateTimers();
     void populateScripts();
@@ -434,6 +437,7 @@ private:
     void recursiveSearchTimers(TTimer*, const QString& text);
     void recursiveSearchKeys(TKey*, const QString& text);
     void recursiveSearchVariables(TVar*, QList<TVar*>&, bool);
+    QStringList linesToSearch(const QString& source, const QString& text) const;
 
     void createSearchOptionIcon();
     void clearEditorNotification() const;
@@ -515,6 +519,8 @@ private:
     QListWidgetItem* mpScriptsMainAreaEditHandlerItem = nullptr;
     bool mIsGrabKey = false;
     QPointer<Host> mpHost;
+    QPointer<QDialog> mpProfilerDialog;
+    QPointer<QTableWidget> mpProfilerTable;
     QList<dlgTriggerPatternEdit*> mTriggerPatternEdit;
     bool mChangingVar = false;
 
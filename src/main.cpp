@@ -280,6 +280,12 @@ int main(int argc, char* argv[])
     const QCommandLineOption steamMode(QStringList() << qsl("steammode"), qsl("Adjusts Mudlet settings to match Steam's requirements."));
     parser.addOption(steamMode);
 
+    const QCommandLineOption replayFile(QStringList() << qsl("replay"), qsl("Replay file to play as fast as possible into the first profile given with --profile"), qsl("replay_file"));
+    parser.addOption(replayFile);
+
+    const QCommandLineOption replayWithoutRendering(QStringList() << qsl("replay-no-render"), qsl("Only draw the main console once the --replay file has been played"));
+    parser.addOption(replayWithoutRendering);
+
     parser.addPositionalArgument("package", "Path to .mpackage file");
 
     const bool parsedCommandLineOk = parser.parse(app->arguments());
@@ -316,6 +322,12 @@ int main(int argc, char* argv[])
                                                                   "                                    predefined game, may be repeated."));
         texts << appendLF.arg(QCoreApplication::translate("main", "       --steammode                  adjusts Mudlet settings to match\n"
                                                                   "                                    Steam's requirements."));
+        texts << appendLF.arg(QCoreApplication::translate("main", "       --replay=<file>              play the replay file into the first\n"
+                                                                  "                                    --profile (which is not connected)\n"
+                                                                  "                                    ignoring its recorded timing, then\n"
+                                                                  "                                    report how long it took."));
+        texts << appendLF.arg(QCoreApplication::translate("main", "       --replay-no-render           only redraw the main console once the\n"
+                                                                  "                                    --replay has finished."));
         texts << appendLF.arg(QCoreApplication::translate("main", "There are other inherited options that arise from the Qt Libraries which are\n"
                                                                   "less likely to be useful for normal use of this application:"));
         // From documentation and from http://qt-project.org/doc/qt-5/qapplication.html:
@@ -428,6 +440,7 @@ int main(int argc, char* argv[])
 
     const QStringList cliProfiles = parser.values(profileToOpen);
     const QStringList onlyProfiles = parser.values(onlyPredefinedProfileToShow);
+    const QString cliReplayFile = parser.isSet(replayFile) ? QFileInfo(parser.value(replayFile)).absoluteFilePath() : QString();
     
     const bool showSplash = parser.isSet(showSplashscreen);
     QImage splashImage = mudlet::getSplashScreen(releaseVersion, publicTestVersion);
@@ -660,7 +673,7 @@ int main(int argc, char* argv[])
     }
     mudlet::self()->show();
 
-    mudlet::self()->startAutoLogin(cliProfiles);
+    mudlet::self()->startAutoLogin(cliProfiles, cliReplayFile, !parser.isSet(replayWithoutRendering));
 
 #if defined(INCLUDE_UPDATER)
     mudlet::self()->checkUpdatesOnStart();
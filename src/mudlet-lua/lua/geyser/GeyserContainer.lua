@@ -105,10 +105,8 @@ end
 --- Responsible for placing/moving/resizing this window to the correct place/size.
 -- Called on window resize events.
 function Geyser.Container:reposition ()
-  local x, y, w, h = self:get_x(), self:get_y(), self:get_width(), self:get_height()
   if self.type ~= "userwindow" then
-    moveWindow(self.name, self:get_x(), self:get_y())
-    resizeWindow(self.name, self:get_width(), self:get_height())
+    setWindowGeometry(self.name, self:get_x(), self:get_y(), self:get_width(), self:get_height())
   end
   -- deal with all children of this container
   for k, v in pairs(self.windowList) do
@@ -41,6 +41,16 @@ function Geyser.Gauge:setValue (currentValue, maxValue, text)
   end
 -- prevent the gauge from overflowing its borders if currentValue > maxValue if gauge is set to be strict
   if self.strict and self.value > 100 then self.value = 100 end
+  -- Size the front label natively if possible, which is a single geometry
+  -- change instead of re-evaluating its constraints in Lua; that never
+  -- overflows the gauge so leave an overflowing value to the code below
+  self.nativeFill = self.value <= 100 and setGaugeValue(self.name, self.value, self.orientation) and true or false
+  if self.nativeFill then
+    if text then
+      self.text:echo(text)
+    end
+    return
+  end
   -- Update gauge in the requested orientation
   local shift = tostring(self.value) .. "%"
   if self.orientation == "horizontal" then
@@ -60,6 +70,15 @@ function Geyser.Gauge:setValue (currentValue, maxValue, text)
   end
 end
 
+--- Overridden reposition to keep a natively sized front label at the right
+-- fill level, as its constraints are not changed by setValue
+function Geyser.Gauge:reposition()
+  Geyser.Container.reposition(self)
+  if self.nativeFill then
+    setGaugeValue(self.name, self.value, self.orientation)
+  end
+end
+
 --- Sets the gauge color.
 -- @param r The red component, or a named color like "green".
 -- @param g the green component, or nil if using a named color.
@@ -21,9 +21,15 @@ Geyser.get_y = function()
   return 0
 end
 Geyser.get_width = function()
+  if Geyser.repositionSize then
+    return Geyser.repositionSize.width
+  end
   return getMainWindowSize()
 end
 Geyser.get_height = function()
+  if Geyser.repositionSize then
+    return Geyser.repositionSize.height
+  end
   local w, h = getMainWindowSize() return h
 end
 Geyser.name = "Geyser Root Window"
@@ -10,12 +10,24 @@
 -- @param h the new height
 -- @param arg additional arguments
 function GeyserReposition(event, w, h, arg)
-  for _, window in pairs(Geyser.windowList) do
-    if event == "sysUserWindowResizeEvent" and window.type == "userwindow" and arg.."Container" == window.name then
-      window:reposition()
-    elseif event == "sysWindowResizeEvent" and window.type ~= "userwindow" then 
-      window:reposition()
+  -- The main window cannot change size while this runs, so look it up once
+  -- rather than every time a constraint relative to it is worked out
+  local width, height = getMainWindowSize()
+  Geyser.repositionSize = { width = width, height = height }
+  -- The cached size must not outlive this call even if a reposition fails,
+  -- so catch any error, keeping where it came from, and raise it again after
+  local ok, err = xpcall(function()
+    for _, window in pairs(Geyser.windowList) do
+      if event == "sysUserWindowResizeEvent" and window.type == "userwindow" and arg.."Container" == window.name then
+        window:reposition()
+      elseif event == "sysWindowResizeEvent" and window.type ~= "userwindow" then
+        window:reposition()
+      end
     end
+  end, debug.traceback)
+  Geyser.repositionSize = nil
+  if not ok then
+    error(err, 0)
   end
 end
 
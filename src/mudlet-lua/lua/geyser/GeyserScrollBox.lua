@@ -12,8 +12,7 @@ Geyser.ScrollBox = Geyser.Window:new({
 -- Overridden reposition for special coordination handling
 function Geyser.ScrollBox:reposition()
     Geyser.calc_constraints(self, self, self.container)
-    moveWindow(self.name, self:get_x(), self:get_y())
-    resizeWindow(self.name, self:get_width(), self:get_height())
+    setWindowGeometry(self.name, self:get_x(), self:get_y(), self:get_width(), self:get_height())
     self.get_x = function() return 0 end
     self.get_y = function() return 0 end
       -- deal with all children of this container
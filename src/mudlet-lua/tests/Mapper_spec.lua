@@ -0,0 +1,215 @@
+-- https://wiki.mudlet.org/w/Manual:Mapper_Functions
+describe("Tests Mapper functions", function()
+
+  -- Makes a fresh area holding the given number of new rooms, laid out in a
+  -- row, and returns the area id and a list of the room ids:
+  local function makeArea(name, roomCount)
+    if getAreaTable()[name] then
+      deleteArea(name)
+    end
+    local areaID = addAreaName(name)
+    local rooms = {}
+    for i = 1, roomCount do
+      local roomID = createRoomID()
+      addRoom(roomID)
+      setRoomArea(roomID, areaID)
+      setRoomCoordinates(roomID, i, 0, 0)
+      rooms[i] = roomID
+    end
+    return areaID, rooms
+  end
+
+  describe("Tests the functionality of getRoomsData", function()
+    local areaID, rooms
+
+    setup(function()
+      areaID, rooms = makeArea("getRoomsData spec area", 2)
+      setRoomName(rooms[1], "First room")
+      setRoomName(rooms[2], "Second room")
+      setRoomUserData(rooms[1], "colour", "blue")
+      setExit(rooms[1], rooms[2], "east")
+    end)
+
+    teardown(function()
+      deleteArea(areaID)
+    end)
+
+    it("should return all the fields of each room keyed by room ID", function()
+      local data = getRoomsData(rooms)
+      assert.are.equal("First room", data[rooms[1]].name)
+      assert.are.equal(areaID, data[rooms[1]].area)
+      assert.are.same({1, 0, 0}, {data[rooms[1]].x, data[rooms[1]].y, data[rooms[1]].z})
+      assert.are.equal(getRoomEnv(rooms[1]), data[rooms[1]].env)
+      assert.are.equal(getRoomWeight(rooms[1]), data[rooms[1]].weight)
+      assert.are.equal(getRoomChar(rooms[1]), data[rooms[1]].symbol)
+      assert.are.equal(roomLocked(rooms[1]), data[rooms[1]].locked)
+      assert.are.same({east = rooms[2]}, data[rooms[1]].exits)
+      assert.are.same({colour = "blue"}, data[rooms[1]].userData)
+      assert.are.equal("Second room", data[rooms[2]].name)
+      assert.are.same({}, data[rooms[2]].exits)
+    end)
+
+    it("should only return the fields asked for", function()
+      local data = getRoomsData({rooms[1]}, {"name", "userData.colour"})
+      assert.are.same({[rooms[1]] = {name = "First room", ["userData.colour"] = "blue"}}, data)
+    end)
+
+    it("should leave out user data items that a room does not have", function()
+      local data = getRoomsData(rooms, {"userData.colour"})
+      assert.are.same({[rooms[1]] = {["userData.colour"] = "blue"}, [rooms[2]] = {}}, data)
+    end)
+
+    it("should leave out rooms that do not exist", function()
+      local missing = createRoomID()
+      local data = getRoomsData({rooms[2], missing}, {"name"})
+      assert.are.same({[rooms[2]] = {name = "Second room"}}, data)
+    end)
+
+    it("should refuse a field that it does not know", function()
+      local result, message = getRoomsData(rooms, {"name", "colour"})
+      assert.is_nil(result)
+      assert.is_truthy(message:find("colour", 1, true))
+    end)
+
+    it("should throw an error when not given a table of room IDs", function()
+      assert.has_error(function() getRoomsData(rooms[1]) end)
+    end)
+  end)
+
+  describe("Tests the functionality of setRoomsData", function()
+    local areaID, otherAreaID, rooms
+
+    before_each(function()
+      areaID, rooms = makeArea("setRoomsData spec area", 2)
+      otherAreaID = makeArea("setRoomsData spec other area", 0)
+      setRoomName(rooms[1], "Before")
+      setRoomUserData(rooms[1], "kept", "yes")
+    end)
+
+    after_each(function()
+      deleteArea(areaID)
+      deleteArea(otherAreaID)
+    end)
+
+    it("should set the given fields of each room", function()
+      assert.is_true(setRoomsData({
+        [rooms[1]] = {name = "After", env = 7, weight = 3, symbol = "X", locked = true},
+        [rooms[2]] = {x = 10, y = -2, z = 1}
+      }))
+      assert.are.equal("After", getRoomName(rooms[1]))
+      assert.are.equal(7, getRoomEnv(rooms[1]))
+      assert.are.equal(3, getRoomWeight(rooms[1]))
+      assert.are.equal("X", getRoomChar(rooms[1]))
+      assert.is_true(roomLocked(rooms[1]))
+      assert.are.same({10, -2, 1}, {getRoomCoordinates(rooms[2])})
+    end)
+
+    it("should merge user data rather than replace it", function()
+      assert.is_true(setRoomsData({[rooms[1]] = {userData = {added = "too"}}}))
+      assert.are.equal("yes", getRoomUserData(rooms[1], "kept"))
+      assert.are.equal("too", getRoomUserData(rooms[1], "added"))
+    end)
+
+    it("should move rooms to another area", function()
+      assert.is_true(setRoomsData({[rooms[1]] = {area = otherAreaID}, [rooms[2]] = {area = otherAreaID}}))
+      assert.are.equal(otherAreaID, getRoomArea(rooms[1]))
+      assert.are.equal(otherAreaID, getRoomArea(rooms[2]))
+      assert.are.same({}, getAreaRooms(areaID))
+    end)
+
+    it("should round trip what getRoomsData returns", function()
+      local data = getRoomsData(rooms, {"name", "x", "y", "z", "env", "weight", "symbol", "locked", "userData"})
+      data[rooms[1]].name = "Round trip"
+      assert.is_true(setRoomsData(data))
+      assert.are.same(data, getRoomsData(rooms, {"name", "x", "y", "z", "env", "weight", "symbol", "locked", "userData"}))
+    end)
+
+    it("should change nothing if any room is missing", function()
+      local result, message = setRoomsData({[rooms[1]] = {name = "Changed"}, [createRoomID()] = {name = "Nowhere"}})
+      assert.is_nil(result)
+      assert.is_truthy(message)
+      assert.are.equal("Before", getRoomName(rooms[1]))
+    end)
+
+    it("should change nothing if any field is unknown or cannot be set", function()
+      assert.is_nil(setRoomsData({[rooms[1]] = {name = "Changed"}, [rooms[2]] = {colour = 5}}))
+      assert.is_nil(setRoomsData({[rooms[1]] = {name = "Changed", exits = {}}}))
+      assert.are.equal("Before", getRoomName(rooms[1]))
+    end)
+
+    it("should change nothing if an area does not exist", function()
+      assert.is_nil(setRoomsData({[rooms[1]] = {name = "Changed", area = -5}}))
+      assert.are.equal("Before", getRoomName(rooms[1]))
+      assert.are.equal(areaID, getRoomArea(rooms[1]))
+    end)
+
+    it("should throw an error for a value of the wrong type", function()
+      assert.has_error(function() setRoomsData({[rooms[1]] = {name = 5}}) end)
+      assert.has_error(function() setRoomsData({[rooms[1]] = {userData = {key = 5}}}) end)
+      assert.are.equal("Before", getRoomName(rooms[1]))
+    end)
+  end)
+
+  describe("Tests the functionality of beginMapUpdate and endMapUpdate", function()
+    local areaID, otherAreaID, rooms, otherRooms
+
+    before_each(function()
+      areaID, rooms = makeArea("beginMapUpdate spec area", 2)
+      otherAreaID, otherRooms = makeArea("beginMapUpdate spec other area", 1)
+    end)
+
+    after_each(function()
+      -- In case a test failed part way through a batch:
+      while endMapUpdate() do end
+      deleteArea(areaID)
+      deleteArea(otherAreaID)
+    end)
+
+    it("should refuse to end a batch that was not begun", function()
+      local result, message = endMapUpdate()
+      assert.is_nil(result)
+      assert.is_truthy(message)
+    end)
+
+    it("should only end a nested batch at the outermost endMapUpdate", function()
+      assert.is_true(beginMapUpdate())
+      assert.is_true(beginMapUpdate())
+      assert.is_true(endMapUpdate())
+      assert.is_true(endMapUpdate())
+      assert.is_nil(endMapUpdate())
+    end)
+
+    it("should work out area exits once the batch ends", function()
+      beginMapUpdate()
+      setExit(rooms[2], otherRooms[1], "east")
+      -- Not done yet:
+      assert.are.same({}, getAreaExits(areaID))
+      endMapUpdate()
+      assert.are.same({rooms[2]}, getAreaExits(areaID))
+      assert.are.same({[rooms[2]] = {east = otherRooms[1]}}, getAreaExits(areaID, true))
+    end)
+
+    it("should get the area exits right for rooms moved during the batch", function()
+      setExit(rooms[2], otherRooms[1], "east")
+      assert.are.same({rooms[2]}, getAreaExits(areaID))
+      beginMapUpdate()
+      setRoomArea(otherRooms[1], areaID)
+      endMapUpdate()
+      assert.are.same({}, getAreaExits(areaID))
+      assert.are.same({}, getAreaExits(otherAreaID))
+    end)
+
+    it("should leave the map as if the changes had been made one at a time", function()
+      local expected = {}
+      beginMapUpdate()
+      for i, roomID in ipairs(rooms) do
+        setRoomCoordinates(roomID, i * 2, -i, 3)
+        expected[roomID] = {x = i * 2, y = -i, z = 3}
+      end
+      setRoomsData({[rooms[1]] = {x = 5}})
+      expected[rooms[1]].x = 5
+      endMapUpdate()
+      assert.are.same(expected, getRoomsData(rooms, {"x", "y", "z"}))
+    end)
+  end)
+end)
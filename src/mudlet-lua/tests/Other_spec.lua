@@ -397,6 +397,70 @@ describe("Tests Other.lua functions", function()
     end)
   end)
 
+  describe("Tests the matches table that trigger scripts are given", function()
+    local triggerIDs
+
+    before_each(function()
+      triggerIDs = {}
+    end)
+
+    after_each(function()
+      for _, id in ipairs(triggerIDs) do
+        killTrigger(id)
+      end
+    end)
+
+    it("should be an ordinary global table holding the numbered and named captures", function()
+      local seen
+      triggerIDs[#triggerIDs + 1] = tempRegexTrigger("^(?<who>\\w+) says '(.+)'$", function()
+        local inPairs = false
+        for name, value in pairs(_G) do
+          if name == "matches" and value == matches then
+            inPairs = true
+          end
+        end
+        seen = {
+          raw = rawget(_G, "matches") == matches,
+          inPairs = inPairs,
+          whole = matches[1],
+          who = matches.who,
+          said = matches[3],
+          count = #matches
+        }
+      end)
+      feedTriggers("Bob says 'hello there'\n")
+      assert.is_nil(getmetatable(_G))
+      assert.are.same({raw = true, inPairs = true, whole = "Bob says 'hello there'", who = "Bob", said = "hello there", count = 3}, seen)
+    end)
+
+    it("should give each trigger that matches a line its own captures", function()
+      local first, second
+      triggerIDs[#triggerIDs + 1] = tempRegexTrigger("^The (\\w+) attacks", function()
+        first = matches[2]
+      end)
+      triggerIDs[#triggerIDs + 1] = tempRegexTrigger("attacks the (\\w+)$", function()
+        second = matches[2]
+      end)
+      feedTriggers("The orc attacks the goblin\n")
+      assert.are.equal("orc", first)
+      assert.are.equal("goblin", second)
+    end)
+
+    it("should keep the capture positions in step for selectCaptureGroup", function()
+      local selected = {}
+      triggerIDs[#triggerIDs + 1] = tempRegexTrigger("^You see (\\w+) and (?<other>\\w+)\\.$", function()
+        selectCaptureGroup(2)
+        selected[#selected + 1] = getSelection()
+        selectCaptureGroup("other")
+        selected[#selected + 1] = getSelection()
+        deselect()
+      end)
+      feedTriggers("You see apples and pears.\n")
+      feedTriggers("You see plums and grapes.\n")
+      assert.are.same({"apples", "pears", "plums", "grapes"}, selected)
+    end)
+  end)
+
     --[[ 
     TODO:
       remember()
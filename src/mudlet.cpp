@@ -104,6 +104,8 @@ namespace coreMacOS {
 // #include <nanobench.h>
 #include "post_guard.h"
 
+#include <iostream>
+
 using namespace std::chrono_literals;
 
 
@@ -2604,22 +2606,45 @@ void mudlet::deleteProfileData(const QString& profile, const QString& item)
 }
 
 // this slot is called via a timer in the constructor of mudlet::mudlet()
-void mudlet::startAutoLogin(const QStringList& cliProfiles)
+void mudlet::startAutoLogin(const QStringList& cliProfiles, const QString& replayFileName, const bool renderReplay)
 {
     QStringList hostList = QDir(getMudletPath(profilesPath)).entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
     hostList += TGameDetails::keys();
     hostList << qsl("Mudlet self-test");
     hostList.removeDuplicates();
     bool openedProfile = false;
+    QString replayProfile;
 
     for (auto& hostName : cliProfiles){
         if (hostList.contains(hostName)) {
-            doAutoLogin(hostName);
+            if (!replayFileName.isEmpty() && replayProfile.isEmpty()) {
+                // A replay given on the command line is played, offline, into
+                // the first profile named there:
+                doAutoLogin(hostName, false);
+                replayProfile = hostName;
+            } else {
+                doAutoLogin(hostName);
+            }
             openedProfile = true;
             hostList.removeOne(hostName);
         }
     }
 
+    if (!replayProfile.isEmpty()) {
+        // Let the main window get drawn before the replay ties up the event loop:
+        QTimer::singleShot(0, this, [this, replayProfile, replayFileName, renderReplay]() {
+            Host* pHost = mHostManager.getHost(replayProfile);
+            if (!pHost || !pHost->mpConsole) {
+                return;
+            }
+            if (loadReplay(pHost, replayFileName, nullptr, true, renderReplay)) {
+                std::cout << pHost->mTelnet.getReplayReport().toStdString() << std::endl;
+            }
+        });
+    } else if (!replayFileName.isEmpty()) {
+        std::cout << tr("Cannot replay \"%1\" as no profile to play it into was given with --profile.").arg(replayFileName).toStdString() << std::endl;
+    }
+
     for (auto& hostName : hostList) {
         const QString val = readProfileData(hostName, qsl("autologin"));
         if (val.toInt() == Qt::Checked) {
@@ -2728,7 +2753,7 @@ void mudlet::attachDebugArea(const QString& hostname)
     smpDebugArea->hide();
 }
 
-void mudlet::doAutoLogin(const QString& profile_name)
+void mudlet::doAutoLogin(const QString& profile_name, const bool connect)
 {
     if (profile_name.isEmpty()) {
         return;
@@ -2736,7 +2761,9 @@ void mudlet::doAutoLogin(const QString& profile_name)
 
     Host* pHost = mHostManager.getHost(profile_name);
     if (pHost) {
-        pHost->mTelnet.connectIt(pHost->getUrl(), pHost->getPort());
+        if (connect) {
+            pHost->mTelnet.connectIt(pHost->getUrl(), pHost->getPort());
+        }
         return;
     }
 
@@ -2798,7 +2825,7 @@ void mudlet::doAutoLogin(const QString& profile_name)
 
     emit signal_hostCreated(pHost, mHostManager.getHostCount());
     emit signal_adjustAccessibleNames();
-    slot_connectionDialogueFinished(profile_name, true);
+    slot_connectionDialogueFinished(profile_name, connect);
     enableToolbarButtons();
     updateMultiViewControls();
 }
@@ -3736,7 +3763,7 @@ void mudlet::showChangelogIfUpdated()
 // non-NULLPTR pErrMsg indicates the former; also the replayFileName CAN be
 // relative (to the profiles ./log sub-directory where replays are stored) if
 // sourced from the lua sub-system.
-bool mudlet::loadReplay(Host* pHost, const QString& replayFileName, QString* pErrMsg)
+bool mudlet::loadReplay(Host* pHost, const QString& replayFileName, QString* pErrMsg, const bool unpaced, const bool render)
 {
     // Do not proceed if there is a problem with the main toolbar (it isn't there)
     // OR if there is already a replay toolbar in existence (a replay is already
@@ -3767,7 +3794,7 @@ bool mudlet::loadReplay(Host* pHost, const QString& replayFileName, QString* pEr
         absoluteReplayFileName = replayFileName;
     }
 
-    return pHost->mTelnet.loadReplay(absoluteReplayFileName, pErrMsg);
+    return pHost->mTelnet.loadReplay(absoluteReplayFileName, pErrMsg, unpaced, render);
 }
 
 void mudlet::slot_newDataOnHost(const QString& hostName, const bool isLowerPriorityChange)
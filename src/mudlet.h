@@ -322,7 +322,7 @@ public:
     void commitLayoutUpdates(bool flush = false);
     void deleteProfileData(const QString &profile, const QString &item);
     void disableToolbarButtons();
-    void doAutoLogin(const QString&);
+    void doAutoLogin(const QString&, bool connect = true);
     void enableToolbarButtons();
     void forceClose();
     void armForceClose();
@@ -342,7 +342,7 @@ public:
     // operating without either menubar or main toolbar showing.
     bool isControlsVisible() const;
     bool isGoingDown() { return mIsGoingDown; }
-    bool loadReplay(Host*, const QString&, QString* pErrMsg = nullptr);
+    bool loadReplay(Host*, const QString&, QString* pErrMsg = nullptr, bool unpaced = false, bool render = true);
     bool loadWindowLayout();
     controlsVisibility menuBarVisibility() const { return mMenuBarVisibility; }
     bool migratePasswordsToProfileStorage();
@@ -399,7 +399,7 @@ public:
     // Brings up the preferences dialog and selects the tab whos objectName is
     // supplied:
     void showOptionsDialog(const QString&);
-    void startAutoLogin(const QStringList&);
+    void startAutoLogin(const QStringList&, const QString& replayFileName = QString(), bool renderReplay = true);
     bool storingPasswordsSecurely() const { return mStorePasswordsSecurely; }
     controlsVisibility toolBarVisibility() const { return mToolbarVisibility; }
     void updateDiscordNamedIcon();
@@ -653,7 +653,9 @@ SOURCES += \
     TEntityResolver.cpp \
     TFlipButton.cpp \
     TForkedProcess.cpp \
+    THighlighter.cpp \
     TimerUnit.cpp \
+    TJsonArraySplicer.cpp \
     TKey.cpp \
     TLabel.cpp \
     TScrollBox.cpp \
@@ -693,9 +695,12 @@ SOURCES += \
     TMxpVersionTagHandler.cpp \
     TMxpVarTagHandler.cpp \
     TriggerUnit.cpp \
+    TProfiler.cpp \
+    TRegexCache.cpp \
     TRoom.cpp \
     TRoomDB.cpp \
     TScript.cpp \
+    TScrollbackArchive.cpp \
     TSplitter.cpp \
     TSplitterHandle.cpp \
     TStringUtils.cpp \
@@ -707,6 +712,7 @@ SOURCES += \
     TTreeWidget.cpp \
     TTrigger.cpp \
     TVar.cpp \
+    TXmlSanitizer.cpp \
     VarUnit.cpp \
     XMLexport.cpp \
     XMLimport.cpp
@@ -787,8 +793,11 @@ HEADERS += \
     TFlipButton.h \
     TForkedProcess.h \
     TGameDetails.h \
+    THighlighter.h \
     TimerUnit.h \
+    TJsonArraySplicer.h \
     TKey.h \
+    TKeyDispatchIndex.h \
     TLabel.h \
     TLinkStore.h \
     TLuaInterpreter.h \
@@ -824,10 +833,13 @@ HEADERS += \
     TMxpVersionTagHandler.h \
     Tree.h \
     TriggerUnit.h \
+    TProfiler.h \
+    TRegexCache.h \
     TRoom.h \
     TRoomDB.h \
     TScript.h \
     TScrollBox.h \
+    TScrollbackArchive.h \
     TSplitter.h \
     TSplitterHandle.h \
     TStringUtils.h \
@@ -840,6 +852,7 @@ HEADERS += \
     TTrigger.h \
     TVar.h \
     VarUnit.h \
+    TXmlSanitizer.h \
     utils.h \
     XMLexport.h \
     XMLimport.h \
@@ -1496,6 +1509,7 @@ LUA_LCF.depends = mudlet
 LUA_TESTS.files = \
     $${PWD}/mudlet-lua/tests/DB_spec.lua \
     $${PWD}/mudlet-lua/tests/GUIUtils_spec.lua \
+    $${PWD}/mudlet-lua/tests/Mapper_spec.lua \
     $${PWD}/mudlet-lua/tests/MudletBusted_spec.lua \
     $${PWD}/mudlet-lua/tests/Other_spec.lua
 LUA_TESTS.depends = mudlet
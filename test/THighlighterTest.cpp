@@ -0,0 +1,168 @@
+#include <THighlighter.h>
+#include <QtTest/QtTest>
+
+#include "utils.h"
+
+class THighlighterTest : public QObject {
+Q_OBJECT
+
+private:
+    // Renders the runs as "begin-end:format" so that a failure shows them all:
+    static QString describe(const QVector<THighlighter::Run>& runs)
+    {
+        QStringList parts;
+        for (const auto& run : runs) {
+            parts << qsl("%1-%2:%3").arg(QString::number(run.mBegin), QString::number(run.mEnd), QString::number(run.mFormat));
+        }
+        return parts.join(QLatin1Char(' '));
+    }
+
+    static int addFormat(THighlighter& highlighter)
+    {
+        THighlighter::Format format;
+        format.mFgColor = QColor(Qt::red);
+        return highlighter.addFormat(format);
+    }
+
+private slots:
+
+    void testLiteralStrings()
+    {
+        THighlighter highlighter;
+        const int format = addFormat(highlighter);
+        highlighter.addString(qsl("orc"), format, false);
+        highlighter.addString(qsl("goblin"), format, false);
+        highlighter.compile();
+
+        QCOMPARE(describe(highlighter.findRuns(qsl("An orc and a goblin and an orc."))), qsl("3-6:0 13-19:0 27-30:0"));
+        QCOMPARE(describe(highlighter.findRuns(qsl("Nothing here."))), QString());
+    }
+
+    void testOverlappingMatches()
+    {
+        THighlighter highlighter;
+        const int first = addFormat(highlighter);
+        const int second = addFormat(highlighter);
+        const int third = addFormat(highlighter);
+        // "he" is found inside "she" and "hers" through the fail links:
+        highlighter.addString(qsl("he"), first, false);
+        highlighter.addString(qsl("she"), second, false);
+        highlighter.addString(qsl("hers"), third, false);
+        highlighter.compile();
+
+        // The leftmost match wins:
+        QCOMPARE(describe(highlighter.findRuns(qsl("ushers"))), qsl("1-4:1"));
+        // ...and the longest one when they start at the same place:
+        QCOMPARE(describe(highlighter.findRuns(qsl("hers"))), qsl("0-4:2"));
+        // Matches that only touch are both kept:
+        QCOMPARE(describe(highlighter.findRuns(qsl("hehe"))), qsl("0-2:0 2-4:0"));
+    }
+
+    void testStringsBeatPatternsForTheSameSpan()
+    {
+        THighlighter highlighter;
+        const int stringFormat = addFormat(highlighter);
+        const int patternFormat = addFormat(highlighter);
+        QString errorMessage;
+        QVERIFY(highlighter.addPattern(qsl("d[a-z]+n"), patternFormat, false, errorMessage));
+        highlighter.addString(qsl("dragon"), stringFormat, false);
+        highlighter.compile();
+
+        QCOMPARE(describe(highlighter.findRuns(qsl("a dragon"))), qsl("2-8:0"));
+        // A longer pattern match starting at the same place still wins:
+        QCOMPARE(describe(highlighter.findRuns(qsl("dragonskin"))), qsl("0-10:1"));
+    }
+
+    void testOnlyTheFirstFormatForAStringIsUsed()
+    {
+        THighlighter highlighter;
+        const int first = addFormat(highlighter);
+        const int second = addFormat(highlighter);
+        highlighter.addString(qsl("troll"), first, false);
+        highlighter.addString(qsl("troll"), second, false);
+        highlighter.compile();
+
+        QCOMPARE(describe(highlighter.findRuns(qsl("troll"))), qsl("0-5:0"));
+    }
+
+    void testWholeWord()
+    {
+        THighlighter highlighter;
+        const int format = addFormat(highlighter);
+        QString errorMessage;
+        highlighter.addString(qsl("cat"), format, true);
+        QVERIFY(highlighter.addPattern(qsl("\\d+"), format, true, errorMessage));
+        highlighter.compile();
+
+        QCOMPARE(describe(highlighter.findRuns(qsl("cat"))), qsl("0-3:0"));
+        QCOMPARE(describe(highlighter.findRuns(qsl("the cat sat"))), qsl("4-7:0"));
+        QCOMPARE(describe(highlighter.findRuns(qsl("(cat)"))), qsl("1-4:0"));
+        QCOMPARE(describe(highlighter.findRuns(qsl("concatenate cats bobcat cat_"))), QString());
+        // Non-ASCII letters and underscores count as word characters:
+        QCOMPARE(describe(highlighter.findRuns(qsl("écat caté"))), QString());
+        QCOMPARE(describe(highlighter.findRuns(qsl("12 x34 56"))), qsl("0-2:0 7-9:0"));
+    }
+
+    void testWholeWordOnlyAppliesToItsOwnEntry()
+    {
+        THighlighter highlighter;
+        const int format = addFormat(highlighter);
+        highlighter.addString(qsl("cat"), format, true);
+        highlighter.addString(qsl("dog"), format, false);
+        highlighter.compile();
+
+        QCOMPARE(describe(highlighter.findRuns(qsl("bobcat hotdogs"))), qsl("10-13:0"));
+    }
+
+    void testEmptyStringsAndPatterns()
+    {
+        THighlighter highlighter;
+        const int format = addFormat(highlighter);
+        QString errorMessage;
+        highlighter.addString(QString(), format, false);
+        // Valid but can only ever match nothing, which is not highlighted:
+        QVERIFY(highlighter.addPattern(QString(), format, false, errorMessage));
+        QVERIFY(highlighter.addPattern(qsl("x*"), format, false, errorMessage));
+        highlighter.compile();
+
+        QCOMPARE(describe(highlighter.findRuns(qsl("abc"))), QString());
+        QCOMPARE(describe(highlighter.findRuns(qsl("axxb"))), qsl("1-3:0"));
+        QCOMPARE(describe(highlighter.findRuns(QString())), QString());
+    }
+
+    void testEmptyHighlighter()
+    {
+        THighlighter highlighter;
+        highlighter.compile();
+
+        QCOMPARE(describe(highlighter.findRuns(qsl("anything at all"))), QString());
+    }
+
+    void testInvalidPattern()
+    {
+        THighlighter highlighter;
+        const int format = addFormat(highlighter);
+        QString errorMessage;
+        QVERIFY(!highlighter.addPattern(qsl("(unclosed"), format, false, errorMessage));
+        QVERIFY(!errorMessage.isEmpty());
+    }
+
+    void testCaseFolding()
+    {
+        THighlighter highlighter;
+        const int stringFormat = addFormat(highlighter);
+        const int patternFormat = addFormat(highlighter);
+        QString errorMessage;
+        // Literal strings are matched exactly:
+        highlighter.addString(qsl("Dragon"), stringFormat, false);
+        // A pattern can ask for case to be folded, including beyond ASCII:
+        QVERIFY(highlighter.addPattern(qsl("(?i)élan"), patternFormat, false, errorMessage));
+        highlighter.compile();
+
+        QCOMPARE(describe(highlighter.findRuns(qsl("Dragon dragon DRAGON"))), qsl("0-6:0"));
+        QCOMPARE(describe(highlighter.findRuns(qsl("élan ÉLAN Élan"))), qsl("0-4:1 5-9:1 10-14:1"));
+    }
+};
+
+#include "THighlighterTest.moc"
+QTEST_MAIN(THighlighterTest)
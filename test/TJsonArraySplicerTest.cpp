@@ -0,0 +1,126 @@
+#include <TJsonArraySplicer.h>
+#include <QtTest/QtTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include "utils.h"
+
+class TJsonArraySplicerTest : public QObject {
+Q_OBJECT
+
+private:
+    // A stand in for a map, with some members sorting before and after the
+    // "areas" array:
+    static QJsonObject mapObject()
+    {
+        QJsonObject object;
+        object.insert(qsl("anchor"), qsl("first"));
+        object.insert(qsl("areaCount"), 3.0);
+        object.insert(qsl("roomCount"), 12.0);
+        object.insert(qsl("userData"), QJsonObject{{qsl("a"), qsl("b")}, {qsl("nested"), QJsonArray{1.0, 2.0}}});
+        object.insert(qsl("zzz"), true);
+        return object;
+    }
+
+    static QJsonObject areaObject(const int id)
+    {
+        QJsonObject area;
+        area.insert(qsl("id"), static_cast<double>(id));
+        area.insert(qsl("name"), qsl("Area %1").arg(id));
+        QJsonArray rooms;
+        for (int i = 0; i < id; ++i) {
+            QJsonObject room;
+            room.insert(qsl("id"), static_cast<double>(id * 100 + i));
+            room.insert(qsl("coordinates"), QJsonArray{static_cast<double>(i), 0.0, -1.0});
+            room.insert(qsl("exits"), QJsonArray{});
+            room.insert(qsl("userData"), QJsonObject{});
+            rooms.append(room);
+        }
+        area.insert(qsl("rooms"), rooms);
+        return area;
+    }
+
+    // What QJsonDocument produces with the whole array in place:
+    static QByteArray wholeText(QJsonObject object, const QVector<QJsonObject>& elements)
+    {
+        QJsonArray array;
+        for (const auto& element : elements) {
+            array.append(element);
+        }
+        object.insert(qsl("areas"), array);
+        return QJsonDocument(object).toJson(QJsonDocument::Indented);
+    }
+
+    static QByteArray splicedText(QJsonObject object, const QVector<QJsonObject>& elements)
+    {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        TJsonArraySplicer splicer(buffer, qsl("areas"));
+        splicer.insertPlaceholder(object);
+        if (!splicer.begin(object)) {
+            return QByteArray();
+        }
+        for (const auto& element : elements) {
+            splicer.appendElement(TJsonArraySplicer::elementText(element));
+        }
+        splicer.end();
+        return buffer.data();
+    }
+
+private slots:
+
+    void testNoElements()
+    {
+        QCOMPARE(splicedText(mapObject(), {}), wholeText(mapObject(), {}));
+    }
+
+    void testOneElement()
+    {
+        const QVector<QJsonObject> areas{areaObject(2)};
+        QCOMPARE(splicedText(mapObject(), areas), wholeText(mapObject(), areas));
+    }
+
+    void testSeveralElements()
+    {
+        const QVector<QJsonObject> areas{areaObject(1), areaObject(0), areaObject(3)};
+        const QByteArray spliced = splicedText(mapObject(), areas);
+        QCOMPARE(spliced, wholeText(mapObject(), areas));
+        // And so it reads back the same, of course:
+        QJsonParseError error;
+        const QJsonDocument document = QJsonDocument::fromJson(spliced, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(document.object().value(qsl("areas")).toArray().count(), 3);
+    }
+
+    void testEmptyElement()
+    {
+        const QVector<QJsonObject> areas{QJsonObject(), areaObject(1)};
+        QCOMPARE(splicedText(mapObject(), areas), wholeText(mapObject(), areas));
+    }
+
+    void testStringsNeedingEscapes()
+    {
+        // A newline in a value is escaped so it does not upset the indenting,
+        // and text that looks like the placeholder is left alone:
+        QJsonObject area = areaObject(1);
+        area.insert(qsl("name"), qsl("Two\nlines with \"quotes\", a tab\tand ünïcödé"));
+        area.insert(qsl("note"), qsl("@areas@not-a-placeholder@"));
+        QJsonObject map = mapObject();
+        map.insert(qsl("description"), qsl("@areas@also-not-a-placeholder@"));
+        const QVector<QJsonObject> areas{area};
+        QCOMPARE(splicedText(map, areas), wholeText(map, areas));
+    }
+
+    void testMissingPlaceholder()
+    {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        TJsonArraySplicer splicer(buffer, qsl("areas"));
+        QVERIFY(!splicer.begin(mapObject()));
+        QVERIFY(buffer.data().isEmpty());
+    }
+};
+
+#include "TJsonArraySplicerTest.moc"
+QTEST_MAIN(TJsonArraySplicerTest)
@@ -0,0 +1,167 @@
+#include <TKeyDispatchIndex.h>
+#include <QtTest/QtTest>
+#include "utils.h"
+
+#include <list>
+#include <memory>
+#include <vector>
+
+// Just enough of a TKey for TKeyDispatchIndex to work with:
+class FakeKey
+{
+public:
+    FakeKey(const QString& name, const Qt::Key key, const Qt::KeyboardModifiers modifiers, FakeKey* pParent = nullptr, const bool isFolder = false)
+    : mName(name)
+    , mKeyCode(key)
+    , mKeyModifiers(modifiers)
+    , mpParent(pParent)
+    , mIsFolder(isFolder)
+    {
+        if (mpParent) {
+            mpParent->mChildren.push_back(this);
+        }
+    }
+
+    Qt::Key getKeyCode() const { return mKeyCode; }
+    Qt::KeyboardModifiers getKeyModifiers() const { return mKeyModifiers; }
+    std::list<FakeKey*>* getChildrenList() const { return &mChildren; }
+    bool isFolder() const { return mIsFolder; }
+    bool isActive() const { return mIsActive; }
+    bool ancestorsActive() const
+    {
+        for (auto pAncestor = mpParent; pAncestor; pAncestor = pAncestor->mpParent) {
+            if (!pAncestor->mIsActive) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    QString mName;
+    Qt::Key mKeyCode;
+    Qt::KeyboardModifiers mKeyModifiers;
+    bool mIsActive = true;
+
+private:
+    FakeKey* mpParent = nullptr;
+    bool mIsFolder = false;
+    mutable std::list<FakeKey*> mChildren;
+};
+
+class TKeyDispatchIndexTest : public QObject {
+Q_OBJECT
+
+private:
+    // Root "A" (F1), folder "folder" (F1) holding "B" (F1) and "D" (Ctrl+F1),
+    // then root "C" (F1):
+    void buildTrees()
+    {
+        mKeys.clear();
+        mRootNodes.clear();
+        mKeys.push_back(std::make_unique<FakeKey>(qsl("A"), Qt::Key_F1, Qt::NoModifier));
+        FakeKey* pA = mKeys.back().get();
+        mKeys.push_back(std::make_unique<FakeKey>(qsl("folder"), Qt::Key_F1, Qt::NoModifier, nullptr, true));
+        FakeKey* pFolder = mKeys.back().get();
+        mKeys.push_back(std::make_unique<FakeKey>(qsl("B"), Qt::Key_F1, Qt::NoModifier, pFolder));
+        mKeys.push_back(std::make_unique<FakeKey>(qsl("D"), Qt::Key_F1, Qt::ControlModifier, pFolder));
+        mKeys.push_back(std::make_unique<FakeKey>(qsl("C"), Qt::Key_F1, Qt::NoModifier));
+        FakeKey* pC = mKeys.back().get();
+        mRootNodes = {pA, pFolder, pC};
+    }
+
+    FakeKey* key(const QString& name) const
+    {
+        for (const auto& pKey : mKeys) {
+            if (pKey->mName == name) {
+                return pKey.get();
+            }
+        }
+        return nullptr;
+    }
+
+    QStringList press(const Qt::Key keyCode, const Qt::KeyboardModifiers modifiers, const bool runAllMatches, bool* pResult = nullptr)
+    {
+        QStringList fired;
+        const bool result = mIndex.dispatch(mRootNodes, keyCode, modifiers, runAllMatches, [&fired](FakeKey* pKey) { fired.append(pKey->mName); });
+        if (pResult) {
+            *pResult = result;
+        }
+        return fired;
+    }
+
+    std::vector<std::unique_ptr<FakeKey>> mKeys;
+    std::list<FakeKey*> mRootNodes;
+    TKeyDispatchIndex<FakeKey> mIndex;
+
+private slots:
+
+    void init()
+    {
+        buildTrees();
+        mIndex.invalidate();
+    }
+
+    void testRunAllFiresInTreeOrder()
+    {
+        bool result = false;
+        QCOMPARE(press(Qt::Key_F1, Qt::NoModifier, true, &result), QStringList({qsl("A"), qsl("B"), qsl("C")}));
+        QVERIFY(result);
+    }
+
+    void testOnlyFirstMatchFiresByDefault()
+    {
+        bool result = false;
+        QCOMPARE(press(Qt::Key_F1, Qt::NoModifier, false, &result), QStringList({qsl("A")}));
+        QVERIFY(result);
+    }
+
+    void testModifiersMustMatchExactly()
+    {
+        QCOMPARE(press(Qt::Key_F1, Qt::ControlModifier, true), QStringList({qsl("D")}));
+        QVERIFY(press(Qt::Key_F1, Qt::ControlModifier | Qt::ShiftModifier, true).isEmpty());
+    }
+
+    void testNoMatchReturnsFalse()
+    {
+        bool result = true;
+        QVERIFY(press(Qt::Key_F2, Qt::NoModifier, true, &result).isEmpty());
+        QVERIFY(!result);
+    }
+
+    void testInactiveBindingsAndAncestorsDoNotFire()
+    {
+        key(qsl("A"))->mIsActive = false;
+        QCOMPARE(press(Qt::Key_F1, Qt::NoModifier, false), QStringList({qsl("B")}));
+
+        key(qsl("folder"))->mIsActive = false;
+        QCOMPARE(press(Qt::Key_F1, Qt::NoModifier, true), QStringList({qsl("C")}));
+
+        // Turning them back on again does not need the index to be rebuilt:
+        key(qsl("A"))->mIsActive = true;
+        key(qsl("folder"))->mIsActive = true;
+        QVERIFY(!mIndex.isDirty());
+        QCOMPARE(press(Qt::Key_F1, Qt::NoModifier, true), QStringList({qsl("A"), qsl("B"), qsl("C")}));
+    }
+
+    void testKeyChangesNeedInvalidation()
+    {
+        press(Qt::Key_F1, Qt::NoModifier, true);
+        key(qsl("C"))->mKeyCode = Qt::Key_F2;
+        // Until told otherwise the index still has the old combination:
+        QCOMPARE(press(Qt::Key_F2, Qt::NoModifier, true), QStringList());
+
+        mIndex.invalidate();
+        QCOMPARE(press(Qt::Key_F2, Qt::NoModifier, true), QStringList({qsl("C")}));
+        QCOMPARE(press(Qt::Key_F1, Qt::NoModifier, true), QStringList({qsl("A"), qsl("B")}));
+    }
+
+    void testAddedBindingsAreFoundAfterInvalidation()
+    {
+        mKeys.push_back(std::make_unique<FakeKey>(qsl("E"), Qt::Key_F1, Qt::NoModifier, key(qsl("folder"))));
+        mIndex.invalidate();
+        QCOMPARE(press(Qt::Key_F1, Qt::NoModifier, true), QStringList({qsl("A"), qsl("B"), qsl("E"), qsl("C")}));
+    }
+};
+
+#include "TKeyDispatchIndexTest.moc"
+QTEST_MAIN(TKeyDispatchIndexTest)
@@ -0,0 +1,140 @@
+#include <TMatchState.h>
+#include <QtTest/QtTest>
+
+class TMatchStateTest : public QObject {
+Q_OBJECT
+
+private slots:
+
+    void testAcquireGivesAFreshState()
+    {
+        TMatchStatePool pool;
+        QVERIFY(pool.empty());
+        auto [pState, evicted] = pool.acquire(3, 5);
+        QVERIFY(pState);
+        QVERIFY(!evicted);
+        QCOMPARE(pool.size(), size_t(1));
+        QCOMPARE(pool.at(0), pState);
+        QCOMPARE(pState->mNumberOfConditions, 3);
+        QCOMPARE(pState->mDelta, 5);
+        QCOMPARE(pState->nextCondition(), 1);
+        QVERIFY(!pState->isComplete());
+        QVERIFY(pState->newLine());
+    }
+
+    void testReleasedStateIsReused()
+    {
+        TMatchStatePool pool;
+        TMatchState* pFirst = pool.acquire(2, 1).first;
+        pFirst->mIsToBeReclaimed = true;
+        pool.reclaim();
+        QVERIFY(pool.empty());
+
+        TMatchState* pSecond = pool.acquire(2, 1).first;
+        QCOMPARE(pSecond, pFirst);
+        QCOMPARE(pool.size(), size_t(1));
+    }
+
+    void testRecycledStateIsReset()
+    {
+        TMatchStatePool pool;
+        TMatchState* pState = pool.acquire(3, 2).first;
+        pState->addCaptures({"first line", "word"}, {0, 6});
+        pState->nameCaptures.append(NameGroupMatches{qMakePair(QStringLiteral("name"), QStringLiteral("word"))});
+        pState->conditionMatched();
+        pState->conditionMatched();
+        pState->newLineArrived();
+        pState->newLineArrived();
+        pState->newLineArrived();
+        QVERIFY(!pState->lineSpacerMatch(1));
+        QVERIFY(pState->isComplete());
+        QVERIFY(!pState->newLine());
+        pState->mIsToBeReclaimed = true;
+        pool.reclaim();
+
+        TMatchState* pRecycled = pool.acquire(4, 7).first;
+        QCOMPARE(pRecycled, pState);
+        QCOMPARE(pRecycled->mNumberOfConditions, 4);
+        QCOMPARE(pRecycled->mDelta, 7);
+        QCOMPARE(pRecycled->nextCondition(), 1);
+        QCOMPARE(pRecycled->mLineCount, 1);
+        QCOMPARE(pRecycled->mSpacer, 0);
+        QVERIFY(!pRecycled->mIsToBeReclaimed);
+        QVERIFY(!pRecycled->isComplete());
+        QVERIFY(pRecycled->newLine());
+        QVERIFY(pRecycled->nameCaptures.isEmpty());
+        QVERIFY(pRecycled->multiCaptureList().empty());
+        QVERIFY(pRecycled->multiCapturePosList().empty());
+    }
+
+    void testCapturesAreSplitPerCondition()
+    {
+        TMatchStatePool pool;
+        TMatchState* pState = pool.acquire(3, 1).first;
+        pState->addCaptures({"a b", "a", "b"}, {0, 0, 2});
+        pState->addCaptures({}, {});
+        pState->addCaptures({"c"}, {4});
+
+        const std::list<std::list<std::string>> expectedCaptures{{"a b", "a", "b"}, {}, {"c"}};
+        const std::list<std::list<int>> expectedPositions{{0, 0, 2}, {}, {4}};
+        QVERIFY(pState->multiCaptureList() == expectedCaptures);
+        QVERIFY(pState->multiCapturePosList() == expectedPositions);
+    }
+
+    void testReclaimKeepsSurvivorsInOrder()
+    {
+        TMatchStatePool pool;
+        std::vector<TMatchState*> states;
+        for (int i = 0; i < 5; ++i) {
+            states.push_back(pool.acquire(2, i).first);
+        }
+        states.at(0)->mIsToBeReclaimed = true;
+        states.at(2)->mIsToBeReclaimed = true;
+        pool.reclaim();
+
+        QCOMPARE(pool.size(), size_t(3));
+        QCOMPARE(pool.at(0), states.at(1));
+        QCOMPARE(pool.at(1), states.at(3));
+        QCOMPARE(pool.at(2), states.at(4));
+
+        // The spares are used before anything new is allocated:
+        TMatchState* pNext = pool.acquire(2, 9).first;
+        QVERIFY(pNext == states.at(0) || pNext == states.at(2));
+        QCOMPARE(pool.at(3), pNext);
+    }
+
+    void testOldestStateIsEvictedAtTheLimit()
+    {
+        TMatchStatePool pool;
+        TMatchState* pOldest = pool.acquire(2, 0).first;
+        TMatchState* pSecondOldest = pool.acquire(2, 1).first;
+        for (size_t i = 2; i < TMatchStatePool::csmMaxActiveStates; ++i) {
+            QVERIFY(!pool.acquire(2, 2).second);
+        }
+        QCOMPARE(pool.size(), TMatchStatePool::csmMaxActiveStates);
+
+        auto [pNewest, evicted] = pool.acquire(2, 42);
+        QVERIFY(evicted);
+        QCOMPARE(pool.size(), TMatchStatePool::csmMaxActiveStates);
+        QCOMPARE(pool.at(0), pSecondOldest);
+        QCOMPARE(pool.at(pool.size() - 1), pNewest);
+        // The evicted state is the one recycled for the new match:
+        QCOMPARE(pNewest, pOldest);
+        QCOMPARE(pNewest->mDelta, 42);
+    }
+
+    void testClear()
+    {
+        TMatchStatePool pool;
+        pool.acquire(2, 1);
+        pool.acquire(2, 1);
+        pool.clear();
+        QVERIFY(pool.empty());
+        TMatchState* pState = pool.acquire(2, 1).first;
+        QCOMPARE(pool.size(), size_t(1));
+        QCOMPARE(pool.at(0), pState);
+    }
+};
+
+#include "TMatchStateTest.moc"
+QTEST_MAIN(TMatchStateTest)
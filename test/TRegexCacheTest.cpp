@@ -0,0 +1,98 @@
+#include <TRegexCache.h>
+#include <QtTest/QtTest>
+
+#include "utils.h"
+
+class TRegexCacheTest : public QObject {
+Q_OBJECT
+
+private:
+    static bool matches(const QSharedPointer<pcre>& re, const QByteArray& subject)
+    {
+        int ovector[30];
+        return pcre_exec(re.data(), nullptr, subject.constData(), subject.size(), 0, 0, ovector, 30) >= 0;
+    }
+
+private slots:
+
+    void testCacheHitSharesTheCompiledPattern()
+    {
+        const QByteArray pattern{"^You see (\\w+)\\.$"};
+        const char* error = nullptr;
+        auto first = TRegexCache::compile(pattern, &error);
+        QVERIFY(first);
+        auto second = TRegexCache::compile(pattern, &error);
+        QVERIFY(second);
+        QCOMPARE(second.data(), first.data());
+        QVERIFY(matches(second, "You see Bob."));
+        QVERIFY(!matches(second, "You see nobody here."));
+    }
+
+    void testDifferentPatternsAreNotShared()
+    {
+        const char* error = nullptr;
+        auto first = TRegexCache::compile("^north$", &error);
+        auto second = TRegexCache::compile("^south$", &error);
+        QVERIFY(first && second);
+        QVERIFY(first.data() != second.data());
+        QVERIFY(matches(first, "north"));
+        QVERIFY(!matches(first, "south"));
+    }
+
+    void testPatternIsEvictedWhenNoLongerUsed()
+    {
+        const QByteArray pattern{"^evict (me|you)$"};
+        const char* error = nullptr;
+        auto re = TRegexCache::compile(pattern, &error);
+        QVERIFY(re);
+        auto copy = re;
+        QVERIFY(TRegexCache::isCached(pattern));
+        re.reset();
+        // Still held by another user:
+        QVERIFY(TRegexCache::isCached(pattern));
+        copy.reset();
+        QVERIFY(!TRegexCache::isCached(pattern));
+
+        // ...and is simply compiled again when next wanted:
+        re = TRegexCache::compile(pattern, &error);
+        QVERIFY(re);
+        QVERIFY(TRegexCache::isCached(pattern));
+        QVERIFY(matches(re, "evict you"));
+    }
+
+    void testExpiredEntriesAreSweptWithoutLosingLiveOnes()
+    {
+        const char* error = nullptr;
+        const QByteArray keptPattern{"^kept$"};
+        auto kept = TRegexCache::compile(keptPattern, &error);
+        QVERIFY(kept);
+        // Enough short lived patterns to pass the sweep threshold more than
+        // once:
+        for (int i = 0; i < 1000; ++i) {
+            const QByteArray pattern{qsl("^temporary %1$").arg(i).toUtf8()};
+            auto re = TRegexCache::compile(pattern, &error);
+            QVERIFY(re);
+        }
+        QVERIFY(!TRegexCache::isCached(qsl("^temporary %1$").arg(0).toUtf8()));
+        QVERIFY(TRegexCache::isCached(keptPattern));
+        QCOMPARE(TRegexCache::compile(keptPattern, &error).data(), kept.data());
+    }
+
+    void testInvalidPattern()
+    {
+        const QByteArray pattern{"^(unclosed"};
+        const char* error = nullptr;
+        auto re = TRegexCache::compile(pattern, &error);
+        QVERIFY(!re);
+        QVERIFY(error);
+        QVERIFY(qstrlen(error) > 0);
+        // Failures are not cached:
+        QVERIFY(!TRegexCache::isCached(pattern));
+        error = nullptr;
+        QVERIFY(!TRegexCache::compile(pattern, &error));
+        QVERIFY(error);
+    }
+};
+
+#include "TRegexCacheTest.moc"
+QTEST_MAIN(TRegexCacheTest)
@@ -0,0 +1,172 @@
+#include <TScrollbackArchive.h>
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+#include "utils.h"
+
+class TScrollbackArchiveTest : public QObject {
+Q_OBJECT
+
+private:
+    QTemporaryDir mDirectory;
+
+    // A line whose text is given and whose formatting is two runs, the second
+    // one with its link index set to the line number so that each line can
+    // be told apart by more than its text:
+    static TScrollbackArchive::Line makeLine(const QString& text, const int number, const bool isPrompt = false)
+    {
+        TScrollbackArchive::Line line;
+        line.mText = text;
+        line.mTime = 1000 + number;
+        line.mIsPrompt = isPrompt;
+        const int split = text.size() / 2;
+        line.mChars.insert(line.mChars.end(), split, TChar(QColor(Qt::red), QColor(Qt::black), TChar::Bold));
+        line.mChars.insert(line.mChars.end(), text.size() - split, TChar(QColor(Qt::green), QColor(Qt::blue), TChar::Underline, number));
+        return line;
+    }
+
+    static void appendLines(TScrollbackArchive& archive, const int from, const int to)
+    {
+        for (int number = from; number < to; ++number) {
+            archive.append(makeLine(qsl("line %1").arg(number), number));
+        }
+    }
+
+    static void verifyLine(const TScrollbackArchive::Line& line, const int number)
+    {
+        const QString text = qsl("line %1").arg(number);
+        QCOMPARE(line.mText, text);
+        QCOMPARE(line.mTime, static_cast<qint64>(1000 + number));
+        QVERIFY(!line.mIsPrompt);
+        QCOMPARE(static_cast<int>(line.mChars.size()), static_cast<int>(text.size()));
+        const TChar& first = line.mChars.front();
+        QCOMPARE(first.foreground(), QColor(Qt::red));
+        QCOMPARE(first.background(), QColor(Qt::black));
+        QVERIFY(first.isBold());
+        QCOMPARE(first.linkIndex(), 0);
+        const TChar& last = line.mChars.back();
+        QCOMPARE(last.foreground(), QColor(Qt::green));
+        QCOMPARE(last.background(), QColor(Qt::blue));
+        QVERIFY(last.isUnderlined());
+        QCOMPARE(last.linkIndex(), number);
+    }
+
+private slots:
+
+    void initTestCase()
+    {
+        QVERIFY(mDirectory.isValid());
+    }
+
+    void testAppendAndLines()
+    {
+        TScrollbackArchive archive(mDirectory.path());
+        QVERIFY(archive.isValid());
+        QCOMPARE(archive.lineCount(), 0);
+        QVERIFY(archive.lines(0, 10).isEmpty());
+
+        appendLines(archive, 0, 3);
+        QCOMPARE(archive.lineCount(), 3);
+        QCOMPARE(archive.lines(0, 2), QStringList({qsl("line 0"), qsl("line 1"), qsl("line 2")}));
+        QCOMPARE(archive.line(1), qsl("line 1"));
+        // The limits are clamped to the lines there are:
+        QCOMPARE(archive.lines(-5, 1), QStringList({qsl("line 0"), qsl("line 1")}));
+        QCOMPARE(archive.lines(2, 100), QStringList({qsl("line 2")}));
+        QVERIFY(archive.lines(2, 1).isEmpty());
+        QCOMPARE(archive.line(3), QString());
+    }
+
+    void testFindBackwards()
+    {
+        TScrollbackArchive archive(mDirectory.path());
+        archive.append(makeLine(qsl("A Dragon"), 0));
+        archive.append(makeLine(qsl("a goblin"), 1));
+        archive.append(makeLine(qsl("a dragon"), 2));
+        archive.append(makeLine(qsl("an orc"), 3));
+
+        QCOMPARE(archive.findBackwards(qsl("dragon"), Qt::CaseSensitive, archive.lineCount()), 2);
+        // Only looks at the lines before the given one:
+        QCOMPARE(archive.findBackwards(qsl("dragon"), Qt::CaseSensitive, 2), -1);
+        QCOMPARE(archive.findBackwards(qsl("dragon"), Qt::CaseInsensitive, 2), 0);
+        // Starting beyond the end is the same as starting at it:
+        QCOMPARE(archive.findBackwards(qsl("orc"), Qt::CaseSensitive, 100), 3);
+        QCOMPARE(archive.findBackwards(qsl("troll"), Qt::CaseSensitive, archive.lineCount()), -1);
+        QCOMPARE(archive.findBackwards(QString(), Qt::CaseSensitive, archive.lineCount()), -1);
+    }
+
+    void testPendingLines()
+    {
+        // Fewer lines than make up a block are held in memory, they are all
+        // taken back even when fewer are asked for:
+        TScrollbackArchive archive(mDirectory.path());
+        appendLines(archive, 0, 10);
+        archive.append(makeLine(qsl("a prompt>"), 10, true));
+        QCOMPARE(archive.lineCount(), 11);
+
+        const std::vector<TScrollbackArchive::Line> lines = archive.takeNewestLines(1);
+        QCOMPARE(static_cast<int>(lines.size()), 11);
+        for (int number = 0; number < 10; ++number) {
+            verifyLine(lines.at(number), number);
+        }
+        QCOMPARE(lines.back().mText, qsl("a prompt>"));
+        QVERIFY(lines.back().mIsPrompt);
+        QCOMPARE(archive.lineCount(), 0);
+        QVERIFY(archive.takeNewestLines(1).empty());
+    }
+
+    void testBlockBoundary()
+    {
+        // Two whole blocks of 256 lines written out and 88 still pending:
+        TScrollbackArchive archive(mDirectory.path());
+        appendLines(archive, 0, 600);
+        QCOMPARE(archive.lineCount(), 600);
+        QCOMPARE(archive.lines(254, 257), QStringList({qsl("line 254"), qsl("line 255"), qsl("line 256"), qsl("line 257")}));
+        QCOMPARE(archive.lines(510, 513), QStringList({qsl("line 510"), qsl("line 511"), qsl("line 512"), qsl("line 513")}));
+        QCOMPARE(archive.line(599), qsl("line 599"));
+        QCOMPARE(archive.findBackwards(qsl("line 3"), Qt::CaseSensitive, 600), 399);
+        QCOMPARE(archive.findBackwards(qsl("line 3"), Qt::CaseSensitive, 30), 3);
+
+        // Asking for one more line than is pending takes the newest written
+        // block as well:
+        std::vector<TScrollbackArchive::Line> lines = archive.takeNewestLines(89);
+        QCOMPARE(static_cast<int>(lines.size()), 88 + 256);
+        for (int index = 0; index < static_cast<int>(lines.size()); ++index) {
+            verifyLine(lines.at(index), 256 + index);
+        }
+        QCOMPARE(archive.lineCount(), 256);
+        QCOMPARE(archive.line(255), qsl("line 255"));
+
+        // Appending after taking lines carries on from what is left:
+        appendLines(archive, 1000, 1300);
+        QCOMPARE(archive.lineCount(), 556);
+        QCOMPARE(archive.lines(255, 256), QStringList({qsl("line 255"), qsl("line 1000")}));
+        QCOMPARE(archive.line(555), qsl("line 1299"));
+
+        lines = archive.takeNewestLines(1000);
+        QCOMPARE(static_cast<int>(lines.size()), 556);
+        verifyLine(lines.front(), 0);
+        verifyLine(lines.at(255), 255);
+        verifyLine(lines.at(256), 1000);
+        verifyLine(lines.back(), 1299);
+        QCOMPARE(archive.lineCount(), 0);
+    }
+
+    void testFoundHighlightIsNotKept()
+    {
+        TScrollbackArchive archive(mDirectory.path());
+        TScrollbackArchive::Line line = makeLine(qsl("found it"), 0);
+        line.mChars.front() = TChar(QColor(Qt::red), QColor(Qt::black), TChar::Bold | TChar::Found);
+        archive.append(std::move(line));
+        // Push it out into a block:
+        appendLines(archive, 1, 256);
+
+        const std::vector<TScrollbackArchive::Line> lines = archive.takeNewestLines(256);
+        QCOMPARE(static_cast<int>(lines.size()), 256);
+        QCOMPARE(lines.front().mText, qsl("found it"));
+        QVERIFY(lines.front().mChars.front().isBold());
+        QVERIFY(!lines.front().mChars.front().isFound());
+    }
+};
+
+#include "TScrollbackArchiveTest.moc"
+QTEST_MAIN(TScrollbackArchiveTest)
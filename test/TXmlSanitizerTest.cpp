@@ -0,0 +1,123 @@
+#include <TXmlSanitizer.h>
+#include <QtTest/QtTest>
+#include <QMap>
+
+#include <string>
+#include <vector>
+
+class TXmlSanitizerTest : public QObject {
+Q_OBJECT
+
+private:
+    // The two pass approach that XMLexport used before the streaming one:
+    // look for each replacement in the whole document and then replace all
+    // of each one that was found in turn:
+    static void replaceAll(std::string& source, const std::string& from, const std::string& to)
+    {
+        std::string newString;
+        newString.reserve(source.length());
+        std::string::size_type lastPos = 0;
+        std::string::size_type findPos;
+        while (std::string::npos != (findPos = source.find(from, lastPos))) {
+            newString.append(source, lastPos, findPos - lastPos);
+            newString += to;
+            lastPos = findPos + from.length();
+        }
+        newString += source.substr(lastPos);
+        source.swap(newString);
+    }
+
+    static std::string twoPassSanitize(std::string output)
+    {
+        QMap<std::string, std::string> replacements{
+                {"&#1;", "￼␁"}, {"&#01;", "￼␁"}, {"&#2;", "￼␂"}, {"&#02;", "￼␂"},
+                {"&#3;", "￼␃"}, {"&#03;", "￼␃"}, {"&#4;", "￼␄"}, {"&#04;", "￼␄"},
+                {"&#5;", "￼␅"}, {"&#05;", "￼␅"}, {"&#6;", "￼␆"}, {"&#06;", "￼␆"},
+                {"&#7;", "￼␇"}, {"&#07;", "￼␇"}, {"&#8;", "￼␈"}, {"&#08;", "￼␈"},
+                {"&#11;", "￼␋"}, {"&#12;", "￼␌"}, {"&#14;", "￼␎"}, {"&#15;", "￼␏"},
+                {"&#10;", "￼␐"}, {"&#16;", "￼␑"}, {"&#18;", "￼␒"}, {"&#19;", "￼␓"},
+                {"&#20;", "￼␔"}, {"&#21;", "￼␕"}, {"&#22;", "￼␖"}, {"&#17;", "￼␗"},
+                {"&#23;", "￼␘"}, {"&#25;", "￼␙"}, {"&#26;", "￼␚"}, {"&#27;", "￼␛"},
+                {"&#28;", "￼␜"}, {"&#29;", "￼␝"}, {"&#30;", "￼␞"}, {"&#31;", "￼␟"},
+                {"&#127;", "￼␡"},
+        };
+        for (auto itReplacement = replacements.cbegin(); itReplacement != replacements.cend(); ++itReplacement) {
+            replaceAll(output, itReplacement.key(), itReplacement.value());
+        }
+        return output;
+    }
+
+    static std::string streamSanitize(const std::string& input, const std::vector<size_t>& chunkSizes)
+    {
+        std::string output;
+        TXmlSanitizer sanitizer(output);
+        size_t position = 0;
+        size_t chunk = 0;
+        while (position < input.size()) {
+            const size_t size = std::min(chunkSizes.at(chunk++ % chunkSizes.size()), input.size() - position);
+            sanitizer.append(input.data() + position, size);
+            position += size;
+        }
+        sanitizer.flush();
+        return output;
+    }
+
+    static std::string sampleDocument()
+    {
+        return std::string(R"(<?xml version="1.0" encoding="UTF-8"?>
+<MudletPackage version="1.001">
+    <Script isActive="yes" isFolder="no">
+        <name>control &amp; characters</name>
+        <script>echo("&#1;&#01;&#2;&#02;&#3;&#03;&#4;&#04;&#5;&#05;&#6;&#06;&#7;&#07;&#8;&#08;")
+echo("&#11;&#12;&#14;&#15;&#10;&#16;&#17;&#18;&#19;&#20;&#21;&#22;&#23;&#25;&#26;&#27;&#28;&#29;&#30;&#31;&#127;")
+-- Not replaced: &#9; &#13; &#24; &#128; &#0001; &#x1B; &# &#; &&#27; &lt;&gt; &quot;
+echo("&#27;[1;31mred&#27;[0m")</script>
+    </Script>
+</MudletPackage>
+&)");
+    }
+
+private slots:
+
+    void testSingleChunkMatchesTwoPass()
+    {
+        const std::string input = sampleDocument();
+        QCOMPARE(streamSanitize(input, {input.size()}), twoPassSanitize(input));
+    }
+
+    void testEveryChunkSizeMatchesTwoPass()
+    {
+        // Small chunk sizes split the references in every possible place:
+        const std::string input = sampleDocument();
+        const std::string expected = twoPassSanitize(input);
+        for (size_t chunkSize = 1; chunkSize <= 16; ++chunkSize) {
+            QCOMPARE(streamSanitize(input, {chunkSize}), expected);
+        }
+        QCOMPARE(streamSanitize(input, {1, 2, 3, 5, 7, 11}), expected);
+    }
+
+    void testReferenceSplitAcrossChunks()
+    {
+        const std::string input = "a&#127;b";
+        const std::string expected = "a￼␡b";
+        QCOMPARE(twoPassSanitize(input), expected);
+        for (size_t split = 1; split < input.size(); ++split) {
+            QCOMPARE(streamSanitize(input, {split, input.size()}), expected);
+        }
+    }
+
+    void testTrailingPartialReferenceIsKept()
+    {
+        QCOMPARE(streamSanitize("text &#2", {3}), std::string("text &#2"));
+        QCOMPARE(streamSanitize("&", {1}), std::string("&"));
+    }
+
+    void testNothingToReplace()
+    {
+        const std::string input = "<name>plain &amp; simple</name>";
+        QCOMPARE(streamSanitize(input, {4}), input);
+    }
+};
+
+#include "TXmlSanitizerTest.moc"
+QTEST_MAIN(TXmlSanitizerTest)